@@ -0,0 +1,78 @@
+#include <Benchmark.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions of the benchmark executable so every
+// heap allocation made by the engine code under measurement gets counted
+
+namespace
+{
+
+std::atomic<uint64_t> allocationsNum = 0;
+
+void* Allocate(size_t size)
+{
+    allocationsNum.fetch_add(1, std::memory_order_relaxed);
+
+    if(auto pointer = std::malloc(size ? size : 1))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* AllocateAligned(size_t size, std::align_val_t alignment)
+{
+    allocationsNum.fetch_add(1, std::memory_order_relaxed);
+
+    auto align = static_cast<size_t>(alignment);
+
+    #ifdef _WIN32
+        auto pointer = _aligned_malloc(size ? size : 1, align);
+    #else
+        // aligned_alloc wants the size to be a multiple of the alignment
+        auto pointer = std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align);
+    #endif
+
+    if(pointer)
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void FreeAligned(void* pointer)
+{
+    #ifdef _WIN32
+        _aligned_free(pointer);
+    #else
+        std::free(pointer);
+    #endif
+}
+
+}
+
+void* operator new(size_t size) { return Allocate(size); }
+void* operator new[](size_t size) { return Allocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+
+namespace lustra
+{
+
+uint64_t GetAllocationsNum()
+{
+    return allocationsNum.load(std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,99 @@
+#include <Benchmark.hpp>
+#include <AssetManager.hpp>
+#include <ModelLoader.hpp>
+#include <TextureAsset.hpp>
+
+#include <array>
+
+namespace
+{
+
+// A size x size grid of vertices split into triangles, like a terrain patch
+std::unique_ptr<aiMesh> CreateGridMesh(unsigned int size)
+{
+    auto mesh = std::make_unique<aiMesh>();
+
+    mesh->mNumVertices = size * size;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+    mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+    mesh->mNumUVComponents[0] = 2;
+
+    for(unsigned int y = 0; y < size; y++)
+    {
+        for(unsigned int x = 0; x < size; x++)
+        {
+            auto i = y * size + x;
+
+            mesh->mVertices[i] = aiVector3D(float(x), 0.0f, float(y));
+            mesh->mNormals[i] = aiVector3D(0.0f, 1.0f, 0.0f);
+            mesh->mTextureCoords[0][i] = aiVector3D(float(x) / size, float(y) / size, 0.0f);
+        }
+    }
+
+    // What aiProcess_GenBoundingBoxes would fill in
+    mesh->mAABB = aiAABB(aiVector3D(0.0f), aiVector3D(float(size - 1), 0.0f, float(size - 1)));
+
+    mesh->mNumFaces = (size - 1) * (size - 1) * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+
+    unsigned int face = 0;
+
+    for(unsigned int y = 0; y + 1 < size; y++)
+    {
+        for(unsigned int x = 0; x + 1 < size; x++)
+        {
+            auto i = y * size + x;
+
+            for(auto indices : { std::array{ i, i + size, i + 1 }, std::array{ i + 1, i + size, i + size + 1 } })
+            {
+                mesh->mFaces[face].mNumIndices = 3;
+                mesh->mFaces[face].mIndices = new unsigned int[3]{ indices[0], indices[1], indices[2] };
+
+                face++;
+            }
+        }
+    }
+
+    return mesh;
+}
+
+}
+
+LUSTRA_BENCHMARK(AssetManager)
+{
+    static constexpr uint64_t loadsNum = 100000;
+
+    // The first loads fill the cache, every measured one is a hit
+    lustra::AssetManager::Get().Load<lustra::TextureAsset>("default", true);
+    lustra::AssetManager::Get().Load<lustra::ModelAsset>("cube", true);
+
+    runner.Measure("AssetManager::Load, cache hit", loadsNum, []()
+    {
+        for(uint64_t i = 0; i < loadsNum / 2; i++)
+        {
+            auto texture = lustra::AssetManager::Get().Load<lustra::TextureAsset>("default", true);
+            auto model = lustra::AssetManager::Get().Load<lustra::ModelAsset>("cube", true);
+
+            lustra::DoNotOptimize(texture.get());
+            lustra::DoNotOptimize(model.get());
+        }
+    });
+}
+
+LUSTRA_BENCHMARK(ModelLoader)
+{
+    static constexpr uint64_t meshesNum = 100;
+
+    auto gridMesh = CreateGridMesh(128);
+
+    runner.Measure("ModelLoader::ProcessMesh, 16k vertices", meshesNum, [&]()
+    {
+        for(uint64_t i = 0; i < meshesNum; i++)
+        {
+            auto mesh = lustra::ModelLoader::Get().ProcessMesh(gridMesh.get(), nullptr);
+
+            lustra::DoNotOptimize(mesh.get());
+        }
+    });
+}
@@ -0,0 +1,111 @@
+#include <Benchmark.hpp>
+
+#include <cereal/archives/json.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+namespace lustra
+{
+
+bool BenchmarkRunner::Register(const std::string& name, Benchmark benchmark)
+{
+    benchmarks.emplace_back(name, std::move(benchmark));
+
+    return true;
+}
+
+void BenchmarkRunner::Run(std::string_view filter)
+{
+    for(auto& [name, benchmark] : benchmarks)
+    {
+        if(name.find(filter) == std::string::npos)
+            continue;
+
+        LLGL::Log::Printf(LLGL::Log::ColorFlags::Bold, "%s\n", name.c_str());
+
+        benchmark(*this);
+    }
+}
+
+void BenchmarkRunner::Measure(
+    const std::string& name,
+    uint64_t operations,
+    const std::function<void()>& function,
+    int repetitions
+)
+{
+    std::vector<float> times;
+    times.reserve(repetitions);
+
+    Timer timer;
+
+    uint64_t allocations = 0;
+
+    for(int i = 0; i < repetitions; i++)
+    {
+        auto allocationsBefore = GetAllocationsNum();
+
+        timer.Reset();
+
+        function();
+
+        times.push_back(timer.GetElapsedMilliseconds());
+
+        allocations = GetAllocationsNum() - allocationsBefore;
+    }
+
+    std::sort(times.begin(), times.end());
+
+    BenchmarkResult result{ name, operations, times.front(), times[times.size() / 2], allocations };
+
+    LLGL::Log::Printf(
+        LLGL::Log::ColorFlags::Blue,
+        "  %-48s best %10.3f ms, median %10.3f ms, %14.1f ops/s, %10llu allocs\n",
+        name.c_str(), result.bestMilliseconds, result.medianMilliseconds, result.GetOperationsPerSecond(),
+        (unsigned long long)result.allocations
+    );
+
+    results.push_back(std::move(result));
+}
+
+bool BenchmarkRunner::Check(bool condition, const std::string& message)
+{
+    if(!condition)
+    {
+        LLGL::Log::Errorf(LLGL::Log::ColorFlags::StdError, "  Check failed: %s\n", message.c_str());
+
+        failedChecksNum++;
+    }
+
+    return condition;
+}
+
+size_t BenchmarkRunner::GetFailedChecksNum() const
+{
+    return failedChecksNum;
+}
+
+const std::vector<BenchmarkResult>& BenchmarkRunner::GetResults() const
+{
+    return results;
+}
+
+bool BenchmarkRunner::WriteJson(const std::filesystem::path& path) const
+{
+    std::ofstream file(path);
+
+    if(!file)
+        return false;
+
+    {
+        cereal::JSONOutputArchive archive(file);
+        archive(cereal::make_nvp("results", results));
+    }
+
+    return file.good();
+}
+
+}
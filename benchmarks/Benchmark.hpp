@@ -0,0 +1,102 @@
+#pragma once
+#include <Singleton.hpp>
+#include <Timer.hpp>
+
+#include <cereal/cereal.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lustra
+{
+
+struct BenchmarkResult
+{
+    std::string name;
+
+    uint64_t operations = 0;
+
+    float bestMilliseconds = 0.0f;
+    float medianMilliseconds = 0.0f;
+
+    // Heap allocations made by the last repetition, once the caches are warm
+    uint64_t allocations = 0;
+
+    double GetOperationsPerSecond() const
+    {
+        return bestMilliseconds > 0.0f ? operations / (bestMilliseconds / 1000.0) : 0.0;
+    }
+
+    template<class Archive>
+    void save(Archive& archive) const
+    {
+        archive(
+            CEREAL_NVP(name), CEREAL_NVP(operations),
+            CEREAL_NVP(bestMilliseconds), CEREAL_NVP(medianMilliseconds),
+            cereal::make_nvp("operationsPerSecond", GetOperationsPerSecond()),
+            CEREAL_NVP(allocations)
+        );
+    }
+};
+
+// Counted by the global operator new replaced in AllocationCounter.cpp
+uint64_t GetAllocationsNum();
+
+// Keeps the compiler from dropping a result nothing else reads
+template<class T>
+void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const volatile void* sink;
+    sink = &value;
+#endif
+}
+
+class BenchmarkRunner : public Singleton<BenchmarkRunner>
+{
+public:
+    using Benchmark = std::function<void(BenchmarkRunner&)>;
+
+    bool Register(const std::string& name, Benchmark benchmark);
+
+    // Only the benchmarks whose name contains the filter, all of them if it's empty
+    void Run(std::string_view filter = {});
+
+    // Runs the function several times and records the best and the median time
+    void Measure(
+        const std::string& name,
+        uint64_t operations,
+        const std::function<void()>& function,
+        int repetitions = 5
+    );
+
+    // For benchmarks that compare an optimized path against the reference one,
+    // a failed check is logged and makes the executable return an error
+    bool Check(bool condition, const std::string& message);
+
+    size_t GetFailedChecksNum() const;
+
+    const std::vector<BenchmarkResult>& GetResults() const;
+
+    // { "results": [...] }, meant to be kept per commit and compared
+    bool WriteJson(const std::filesystem::path& path) const;
+
+private:
+    std::vector<std::pair<std::string, Benchmark>> benchmarks;
+    std::vector<BenchmarkResult> results;
+
+    size_t failedChecksNum = 0;
+};
+
+}
+
+#define LUSTRA_BENCHMARK(benchmarkName)                                      \
+    static void benchmarkName(lustra::BenchmarkRunner& runner);              \
+    static bool benchmarkName##Registered =                                  \
+        lustra::BenchmarkRunner::Get().Register(#benchmarkName, benchmarkName); \
+    static void benchmarkName(lustra::BenchmarkRunner& runner)
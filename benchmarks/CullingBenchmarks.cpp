@@ -0,0 +1,91 @@
+#include <Benchmark.hpp>
+#include <BoundsBatch.hpp>
+#include <Multithreading.hpp>
+
+#include <atomic>
+#include <random>
+
+LUSTRA_BENCHMARK(CullingKernel)
+{
+    static constexpr size_t boxesNum = 100000;
+    static constexpr uint64_t iterationsNum = 10;
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f), size(0.5f, 5.0f);
+
+    std::vector<lustra::AABB> boxes(boxesNum);
+
+    lustra::BoundsBatch batch;
+    batch.Reserve(boxesNum);
+
+    for(auto& box : boxes)
+    {
+        glm::vec3 center(position(random), position(random) * 0.1f, position(random));
+        glm::vec3 extent(size(random), size(random), size(random));
+
+        box = { center - extent, center + extent };
+
+        batch.Add(box);
+    }
+
+    // Looking along one diagonal, most boxes are behind or beside the camera
+    lustra::Frustum frustum(
+        glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f)
+            * glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(100.0f, 0.0f, 100.0f), glm::vec3(0.0f, 1.0f, 0.0f))
+    );
+
+    std::vector<uint8_t> expected(boxesNum), visible(boxesNum);
+
+    for(size_t i = 0; i < boxesNum; i++)
+        expected[i] = frustum.Intersects(boxes[i]);
+
+    auto& kernel = lustra::CullingKernel::Get();
+
+    auto defaultInstructionSet = kernel.GetInstructionSet();
+
+    using InstructionSet = lustra::CullingKernel::InstructionSet;
+
+    for(auto instructionSet : { InstructionSet::Scalar, InstructionSet::SSE, InstructionSet::AVX2 })
+    {
+        if(!kernel.IsSupported(instructionSet))
+            continue;
+
+        kernel.SetInstructionSet(instructionSet);
+
+        std::string name(lustra::TransformKernel::GetName(instructionSet));
+
+        kernel.Cull(frustum, batch, visible.data());
+
+        runner.Check(visible == expected, name + " culling differs from Frustum::Intersects");
+
+        runner.Measure("CullingKernel::Cull, " + name, iterationsNum * boxesNum, [&]()
+        {
+            for(uint64_t i = 0; i < iterationsNum; i++)
+                lustra::DoNotOptimize(kernel.Cull(frustum, batch, visible.data()));
+        });
+    }
+
+    kernel.SetInstructionSet(defaultInstructionSet);
+
+    // The way Scene::RenderMeshes splits it
+    runner.Measure("CullingKernel::Cull, ParallelFor", iterationsNum * boxesNum, [&]()
+    {
+        for(uint64_t i = 0; i < iterationsNum; i++)
+        {
+            std::atomic<size_t> visibleNum = 0;
+
+            lustra::Multithreading::Get().ParallelFor(
+                boxesNum,
+                [&](size_t begin, size_t end)
+                {
+                    visibleNum += kernel.Cull(frustum, batch, begin, end, visible.data());
+                },
+                4096
+            );
+
+            lustra::DoNotOptimize(visibleNum.load());
+        }
+    });
+
+    runner.Check(visible == expected, "Culling in parallel differs from Frustum::Intersects");
+}
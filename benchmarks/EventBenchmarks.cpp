@@ -0,0 +1,86 @@
+#include <Benchmark.hpp>
+#include <EventManager.hpp>
+#include <EventBus.hpp>
+
+namespace
+{
+
+// Stands in for CollisionEvent without needing a Jolt contact manifold
+class ContactEvent : public lustra::Event
+{
+public:
+    ContactEvent(float penetration = 0.0f)
+        : Event(Type::Collision), penetration(penetration) {}
+
+    float GetPenetration() const { return penetration; }
+
+private:
+    float penetration;
+};
+
+class ContactListener : public lustra::EventListener
+{
+public:
+    void OnEvent(lustra::Event& event) override
+    {
+        if(auto contactEvent = dynamic_cast<ContactEvent*>(&event))
+            penetration += contactEvent->GetPenetration();
+    }
+
+    void OnEvent(ContactEvent& event)
+    {
+        penetration += event.GetPenetration();
+    }
+
+public:
+    float penetration = 0.0f;
+};
+
+}
+
+LUSTRA_BENCHMARK(Events)
+{
+    static constexpr uint64_t eventsNum = 100000;
+
+    ContactListener listener;
+
+    lustra::EventManager::Get().AddListener(lustra::Event::Type::Collision, &listener);
+    lustra::EventBus::Get().AddListener<ContactEvent>(&listener);
+
+    runner.Measure("EventManager::Dispatch", eventsNum, []()
+    {
+        for(uint64_t i = 0; i < eventsNum; i++)
+            lustra::EventManager::Get().Dispatch(std::make_unique<ContactEvent>(0.01f));
+    });
+
+    runner.Measure("EventBus::Dispatch", eventsNum, []()
+    {
+        for(uint64_t i = 0; i < eventsNum; i++)
+        {
+            ContactEvent event(0.01f);
+            lustra::EventBus::Get().Dispatch(event);
+        }
+    });
+
+    runner.Measure("EventManager::Post + Flush", eventsNum, []()
+    {
+        for(uint64_t i = 0; i < eventsNum; i++)
+            lustra::EventManager::Get().Post(std::make_unique<ContactEvent>(0.01f));
+
+        lustra::EventManager::Get().Flush();
+    });
+
+    runner.Measure("EventBus::Post + Flush", eventsNum, []()
+    {
+        for(uint64_t i = 0; i < eventsNum; i++)
+            lustra::EventBus::Get().Post(ContactEvent(0.01f));
+
+        lustra::EventBus::Get().Flush<ContactEvent>();
+    });
+
+    // The ring and the overflow buffer keep their storage, only the first repetition grows them
+    runner.Check(runner.GetResults().back().allocations == 0, "EventBus::Post + Flush allocated once warm");
+
+    lustra::EventManager::Get().RemoveListener(lustra::Event::Type::Collision, &listener);
+    lustra::EventBus::Get().RemoveListener<ContactEvent>(&listener);
+}
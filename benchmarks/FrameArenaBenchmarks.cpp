@@ -0,0 +1,52 @@
+#include <Benchmark.hpp>
+#include <FrameArena.hpp>
+
+#include <numeric>
+
+namespace
+{
+
+// About what a frame of Scene::RenderMeshes and Scene::SetupLights builds
+constexpr uint64_t framesNum = 100;
+constexpr size_t scratchVectorsNum = 16;
+constexpr size_t scratchSize = 4096;
+
+template<class Vector>
+void FillScratch(Vector& vector)
+{
+    vector.resize(scratchSize);
+
+    std::iota(vector.begin(), vector.end(), 0u);
+}
+
+}
+
+LUSTRA_BENCHMARK(FrameArena)
+{
+    runner.Measure("std::vector scratch", framesNum, []()
+    {
+        for(uint64_t frame = 0; frame < framesNum; frame++)
+        {
+            for(size_t i = 0; i < scratchVectorsNum; i++)
+            {
+                std::vector<uint32_t> scratch;
+                FillScratch(scratch);
+            }
+        }
+    });
+
+    // The first repetition grows the arena, the following ones don't allocate at all
+    runner.Measure("FrameVector scratch", framesNum, []()
+    {
+        for(uint64_t frame = 0; frame < framesNum; frame++)
+        {
+            for(size_t i = 0; i < scratchVectorsNum; i++)
+            {
+                lustra::FrameVector<uint32_t> scratch(lustra::FrameArena::Get().GetResource());
+                FillScratch(scratch);
+            }
+
+            lustra::FrameArena::Get().Reset();
+        }
+    });
+}
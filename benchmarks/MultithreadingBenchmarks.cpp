@@ -0,0 +1,126 @@
+#include <Benchmark.hpp>
+#include <Multithreading.hpp>
+#include <SystemScheduler.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+
+// Roughly what decoding a small image chunk costs
+void Work()
+{
+    volatile float accumulator = 0.0f;
+
+    for(int i = 0; i < 2000; i++)
+        accumulator = accumulator + std::sqrt(float(i));
+}
+
+// Stand-in for the data systems declare access to
+struct Data {};
+
+}
+
+LUSTRA_BENCHMARK(MultithreadingJobs)
+{
+    static constexpr uint64_t jobsNum = 1000;
+
+    runner.Measure("std::async per job", jobsNum, []()
+    {
+        std::vector<std::future<void>> futures;
+        futures.reserve(jobsNum);
+
+        for(uint64_t i = 0; i < jobsNum; i++)
+            futures.push_back(std::async(std::launch::async, Work));
+
+        for(auto& future : futures)
+            future.wait();
+    });
+
+    runner.Measure("Multithreading::AddJob", jobsNum, []()
+    {
+        uint64_t completed = 0;
+
+        for(uint64_t i = 0; i < jobsNum; i++)
+            lustra::Multithreading::Get().AddJob({ Work, [&]() { completed++; } });
+
+        while(completed < jobsNum)
+            lustra::Multithreading::Get().Update();
+    });
+
+    // A job that throws fails its dependents, unless they ask to run anyway
+    auto& multithreading = lustra::Multithreading::Get();
+
+    bool skippedRan = false, reporterRan = false;
+
+    auto failing = multithreading.Schedule([]() { throw std::runtime_error("Expected failure"); });
+    auto skipped = multithreading.Schedule([&]() { skippedRan = true; }, { failing });
+    auto reporter = multithreading.Schedule(
+        [&]() { reporterRan = true; },
+        { failing },
+        lustra::Multithreading::JobThread::Main,
+        lustra::Multithreading::JobPriority::Visible,
+        {},
+        lustra::Multithreading::DependencyFailure::Run
+    );
+
+    while(!skipped->IsFinished() || !reporter->IsFinished())
+        multithreading.Update();
+
+    runner.Check(failing->IsFailed() && skipped->IsFailed() && !skippedRan, "Multithreading ran a job whose dependency failed");
+    runner.Check(reporterRan && !reporter->IsFailed(), "Multithreading skipped a job that runs on failure");
+}
+
+LUSTRA_BENCHMARK(SystemScheduler)
+{
+    static constexpr int systemsNum = 8;
+    static constexpr int workPerSystem = 50;
+
+    auto heavyWork = []()
+    {
+        for(int i = 0; i < workPerSystem; i++)
+            Work();
+    };
+
+    lustra::SystemScheduler independent;
+
+    // Nothing declared, nothing conflicts, so they all run at the same time
+    for(int i = 0; i < systemsNum; i++)
+        independent.AddSystem("Independent", [&](float) { heavyWork(); });
+
+    runner.Measure("Systems called in order", systemsNum * workPerSystem, [&]()
+    {
+        for(int i = 0; i < systemsNum; i++)
+            heavyWork();
+    });
+
+    runner.Measure("SystemScheduler::Update, independent systems", systemsNum * workPerSystem, [&]()
+    {
+        independent.Update(0.0f);
+    });
+
+    // A writer, two readers that may overlap, then a writer that has to wait for both
+    lustra::SystemScheduler chain;
+
+    std::atomic<int> step = 0;
+    std::atomic<bool> ordered = true;
+
+    auto callingThread = std::this_thread::get_id();
+
+    chain.AddSystem("Writer", [&](float) { ordered = ordered && step++ == 0; }).Writes<Data>();
+    chain.AddSystem("Reader", [&](float) { ordered = ordered && step++ >= 1; }).Reads<Data>();
+    chain.AddSystem("Reader", [&](float) { ordered = ordered && step++ >= 1; }).Reads<Data>();
+    chain.AddSystem("Main", [&](float)
+    {
+        ordered = ordered && step++ == 3 && std::this_thread::get_id() == callingThread;
+    }).Writes<Data>().OnMainThread();
+
+    for(int i = 0; i < 100 && ordered; i++)
+    {
+        step = 0;
+        chain.Update(0.0f);
+    }
+
+    runner.Check(ordered, "SystemScheduler ran conflicting systems out of order");
+}
@@ -0,0 +1,622 @@
+#include <Benchmark.hpp>
+#include <Entity.hpp>
+#include <SceneLoader.hpp>
+#include <FrameArena.hpp>
+
+#include <random>
+
+namespace
+{
+
+constexpr size_t chainsNum = 256;
+
+// chainsNum chains of the given depth, returns the deepest entity of each
+std::vector<entt::entity> CreateChains(lustra::Scene& scene, size_t depth, std::vector<entt::entity>* roots = nullptr)
+{
+    std::vector<entt::entity> leaves;
+
+    for(size_t i = 0; i < chainsNum; i++)
+    {
+        lustra::Entity parent;
+
+        for(size_t j = 0; j < depth; j++)
+        {
+            auto entity = scene.CreateEntity();
+
+            entity.AddComponent<lustra::NameComponent>("Node " + std::to_string(j));
+
+            auto& transform = entity.AddComponent<lustra::TransformComponent>();
+            transform.SetPosition({ 1.0f, 0.5f, 0.0f });
+            transform.SetEulerAngles({ 0.0f, 10.0f, 0.0f });
+
+            if(parent)
+                scene.ReparentEntity(entity, parent);
+            else if(roots)
+                roots->push_back(entity);
+
+            parent = entity;
+        }
+
+        leaves.push_back(parent);
+    }
+
+    return leaves;
+}
+
+}
+
+LUSTRA_BENCHMARK(SceneHierarchy)
+{
+    static constexpr uint64_t iterationsNum = 100;
+
+    for(size_t depth : { 8, 64 })
+    {
+        lustra::Scene scene;
+
+        std::vector<entt::entity> roots;
+
+        auto leaves = CreateChains(scene, depth, &roots);
+
+        runner.Measure(
+            "Scene::GetWorldTransform, depth " + std::to_string(depth),
+            iterationsNum * leaves.size(),
+            [&]()
+            {
+                glm::vec4 sum{};
+
+                for(uint64_t i = 0; i < iterationsNum; i++)
+                    for(auto leaf : leaves)
+                        sum += scene.GetWorldTransform(leaf)[3];
+
+                lustra::DoNotOptimize(sum);
+            }
+        );
+
+        auto entitiesNum = leaves.size() * depth;
+
+        scene.UpdateWorldTransforms();
+
+        runner.Measure(
+            "Scene::UpdateWorldTransforms, depth " + std::to_string(depth) + ", unchanged",
+            iterationsNum * entitiesNum,
+            [&]()
+            {
+                for(uint64_t i = 0; i < iterationsNum; i++)
+                {
+                    scene.UpdateWorldTransforms();
+
+                    lustra::FrameArena::Get().Reset();
+                }
+            }
+        );
+
+        // Every root moves, so every world transform gets recomposed
+        runner.Measure(
+            "Scene::UpdateWorldTransforms, depth " + std::to_string(depth) + ", roots moved",
+            iterationsNum * entitiesNum,
+            [&]()
+            {
+                for(uint64_t i = 0; i < iterationsNum; i++)
+                {
+                    for(auto root : roots)
+                    {
+                        auto& transform = scene.GetRegistry().get<lustra::TransformComponent>(root);
+                        transform.SetPosition(transform.GetPosition() + glm::vec3(1.0f, 0.0f, 0.0f));
+                    }
+
+                    scene.UpdateWorldTransforms();
+
+                    lustra::FrameArena::Get().Reset();
+                }
+            }
+        );
+    }
+
+    std::vector<lustra::TransformComponent> transforms(10000);
+
+    for(size_t i = 0; i < transforms.size(); i++)
+    {
+        transforms[i].SetPosition({ float(i), 0.0f, 0.0f });
+        transforms[i].SetEulerAngles({ 0.0f, float(i % 360), 0.0f });
+    }
+
+    runner.Measure("TransformComponent::GetTransform, cached", iterationsNum * transforms.size(), [&]()
+    {
+        glm::vec4 sum{};
+
+        for(uint64_t i = 0; i < iterationsNum; i++)
+            for(auto& transform : transforms)
+                sum += transform.GetTransform()[3];
+
+        lustra::DoNotOptimize(sum);
+    });
+
+    // What a moving body costs every frame, the rotation comes in as a quaternion
+    runner.Measure("TransformComponent::GetTransform, modified", iterationsNum * transforms.size(), [&]()
+    {
+        glm::vec4 sum{};
+
+        auto step = glm::angleAxis(0.01f, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        for(uint64_t i = 0; i < iterationsNum; i++)
+        {
+            for(auto& transform : transforms)
+            {
+                transform.SetRotation(step * transform.GetRotation());
+
+                sum += transform.GetTransform()[3];
+            }
+        }
+
+        lustra::DoNotOptimize(sum);
+    });
+}
+
+LUSTRA_BENCHMARK(SceneForest)
+{
+    static constexpr size_t treesNum = 1000;
+    static constexpr size_t treeSize = 100;
+
+    static constexpr uint64_t iterationsNum = 10;
+
+    lustra::Scene scene;
+
+    std::vector<entt::entity> nodes, roots;
+
+    std::mt19937 random(42);
+
+    // Every node hangs off a random earlier node of its tree
+    for(size_t i = 0; i < treesNum; i++)
+    {
+        auto treeBegin = nodes.size();
+
+        for(size_t j = 0; j < treeSize; j++)
+        {
+            auto entity = scene.CreateEntity();
+
+            auto& transform = entity.AddComponent<lustra::TransformComponent>();
+            transform.SetPosition({ 0.5f, 1.0f, 0.0f });
+            transform.SetEulerAngles({ 0.0f, 5.0f, 0.0f });
+
+            if(j > 0)
+            {
+                auto parent = nodes[treeBegin + random() % j];
+
+                scene.ReparentEntity(entity, scene.GetEntity((entt::id_type)parent));
+            }
+            else
+                roots.push_back(entity);
+
+            nodes.push_back(entity);
+        }
+    }
+
+    auto nodesNum = nodes.size();
+
+    // Scripts keep these across frames, sorting the hierarchy must not move them
+    std::vector<lustra::TransformComponent*> transforms;
+
+    for(auto node : nodes)
+        transforms.push_back(&scene.GetRegistry().get<lustra::TransformComponent>(node));
+
+    runner.Measure("Scene::GetWorldTransform, every node of a 100k forest", iterationsNum * nodesNum, [&]()
+    {
+        glm::vec4 sum{};
+
+        for(uint64_t i = 0; i < iterationsNum; i++)
+            for(auto node : nodes)
+                sum += scene.GetWorldTransform(node)[3];
+
+        lustra::DoNotOptimize(sum);
+    });
+
+    scene.UpdateWorldTransforms();
+
+    runner.Measure("Scene::UpdateWorldTransforms, 100k forest, roots moved", iterationsNum * nodesNum, [&]()
+    {
+        for(uint64_t i = 0; i < iterationsNum; i++)
+        {
+            for(auto root : roots)
+            {
+                auto& transform = scene.GetRegistry().get<lustra::TransformComponent>(root);
+                transform.SetPosition(transform.GetPosition() + glm::vec3(1.0f, 0.0f, 0.0f));
+            }
+
+            scene.UpdateWorldTransforms();
+
+            lustra::FrameArena::Get().Reset();
+        }
+    });
+
+    runner.Measure("Scene::UpdateWorldTransforms, 100k forest, unchanged", iterationsNum * nodesNum, [&]()
+    {
+        for(uint64_t i = 0; i < iterationsNum; i++)
+        {
+            scene.UpdateWorldTransforms();
+
+            lustra::FrameArena::Get().Reset();
+        }
+    });
+
+    // Moving one leaf to another root makes the next update sort the hierarchy again
+    runner.Measure("Scene::UpdateWorldTransforms, 100k forest, after a reparent", iterationsNum * nodesNum, [&]()
+    {
+        for(uint64_t i = 0; i < iterationsNum; i++)
+        {
+            auto leaf = scene.GetEntity((entt::id_type)nodes[treeSize - 1]);
+
+            scene.ReparentEntity(leaf, scene.GetEntity((entt::id_type)roots[(i + 1) % treesNum]));
+
+            scene.UpdateWorldTransforms();
+
+            lustra::FrameArena::Get().Reset();
+        }
+    });
+
+    bool transformsKept = true;
+
+    for(size_t i = 0; i < nodesNum; i++)
+        transformsKept &= transforms[i] == &scene.GetRegistry().get<lustra::TransformComponent>(nodes[i]);
+
+    runner.Check(transformsKept, "Scene::SortHierarchy moved the TransformComponent storage");
+}
+
+LUSTRA_BENCHMARK(SceneNames)
+{
+    static constexpr size_t entitiesNum = 10000;
+    static constexpr uint64_t lookupsNum = 100000;
+
+    lustra::Scene scene;
+
+    std::vector<std::string> names;
+
+    for(size_t i = 0; i < entitiesNum; i++)
+    {
+        names.push_back("Entity " + std::to_string(i));
+
+        scene.CreateEntity().AddComponent<lustra::NameComponent>(names.back());
+    }
+
+    std::mt19937 random(42);
+
+    std::vector<size_t> queries(lookupsNum);
+
+    for(auto& query : queries)
+        query = random() % entitiesNum;
+
+    runner.Measure("Scene::GetEntity(name), 10k entities", lookupsNum, [&]()
+    {
+        for(auto query : queries)
+            lustra::DoNotOptimize(scene.GetEntity(names[query]));
+    });
+
+    runner.Measure("Scene::RenameEntity, 10k entities", lookupsNum, [&]()
+    {
+        for(uint64_t i = 0; i < lookupsNum; i++)
+        {
+            auto query = queries[i];
+
+            scene.RenameEntity(scene.GetEntity(names[query]), names[query]);
+        }
+    });
+
+    auto found = scene.GetEntity(names[entitiesNum / 2]);
+
+    runner.Check(
+        found && found.GetComponent<lustra::NameComponent>().name == names[entitiesNum / 2],
+        "Scene::GetEntity didn't find " + names[entitiesNum / 2]
+    );
+
+    runner.Check(scene.GetEntities("Entity 1").size() == 1, "Scene::GetEntities found the wrong number of entities");
+}
+
+LUSTRA_BENCHMARK(SceneBounds)
+{
+    static constexpr size_t entitiesNum = 20000;
+    static constexpr uint64_t iterationsNum = 10;
+    static constexpr uint64_t queriesNum = 1000;
+
+    lustra::Scene scene;
+
+    std::vector<entt::entity> entities;
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> distribution(-500.0f, 500.0f);
+
+    for(size_t i = 0; i < entitiesNum; i++)
+    {
+        auto entity = scene.CreateEntity();
+
+        entity.AddComponent<lustra::TransformComponent>().SetPosition({ distribution(random), 0.0f, distribution(random) });
+        entity.AddComponent<lustra::MeshComponent>();
+
+        entities.push_back(entity);
+    }
+
+    scene.UpdateWorldTransforms();
+    scene.UpdateBounds();
+
+    lustra::FrameArena::Get().Reset();
+
+    runner.Measure("Scene::UpdateBounds, 20k entities, unchanged", iterationsNum * entitiesNum, [&]()
+    {
+        for(uint64_t i = 0; i < iterationsNum; i++)
+        {
+            scene.UpdateBounds();
+
+            lustra::FrameArena::Get().Reset();
+        }
+    });
+
+    // Small steps mostly stay inside the fat boxes, so few leaves get reinserted
+    runner.Measure("Scene::UpdateBounds, 20k entities, every entity moved", iterationsNum * entitiesNum, [&]()
+    {
+        for(uint64_t i = 0; i < iterationsNum; i++)
+        {
+            for(auto entity : entities)
+            {
+                auto& transform = scene.GetRegistry().get<lustra::TransformComponent>(entity);
+                transform.SetPosition(transform.GetPosition() + glm::vec3(0.01f, 0.0f, 0.0f));
+            }
+
+            scene.UpdateWorldTransforms();
+            scene.UpdateBounds();
+
+            lustra::FrameArena::Get().Reset();
+        }
+    });
+
+    std::vector<lustra::Sphere> spheres(queriesNum);
+
+    for(auto& sphere : spheres)
+        sphere = { { distribution(random), 0.0f, distribution(random) }, 20.0f };
+
+    auto view = scene.GetRegistry().view<lustra::WorldBoundsComponent>();
+
+    size_t bvhHits = 0, linearHits = 0;
+
+    runner.Measure("Scene::QueryBounds, sphere, 20k entities", queriesNum, [&]()
+    {
+        bvhHits = 0;
+
+        for(auto& sphere : spheres)
+            scene.QueryBounds(sphere, [&](entt::entity) { bvhHits++; });
+    });
+
+    runner.Measure("Linear scan, sphere, 20k entities", queriesNum, [&]()
+    {
+        linearHits = 0;
+
+        for(auto& sphere : spheres)
+            for(auto entity : view)
+                linearHits += sphere.Intersects(view.get<lustra::WorldBoundsComponent>(entity).bounds);
+    });
+
+    runner.Check(bvhHits == linearHits, "Scene::QueryBounds found " + std::to_string(bvhHits) + " entities instead of " + std::to_string(linearHits));
+
+    auto viewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f)
+        * glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(100.0f, 0.0f, 100.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    lustra::Frustum frustum(viewProjection);
+
+    runner.Measure("Scene::QueryBounds, frustum, 20k entities", queriesNum, [&]()
+    {
+        bvhHits = 0;
+
+        for(uint64_t i = 0; i < queriesNum; i++)
+            scene.QueryBounds(frustum, [&](entt::entity) { bvhHits++; });
+    });
+
+    runner.Measure("Linear scan, frustum, 20k entities", queriesNum, [&]()
+    {
+        linearHits = 0;
+
+        for(uint64_t i = 0; i < queriesNum; i++)
+            for(auto entity : view)
+                linearHits += frustum.Intersects(view.get<lustra::WorldBoundsComponent>(entity).bounds);
+    });
+
+    runner.Check(bvhHits == linearHits, "Scene::QueryBounds found " + std::to_string(bvhHits) + " entities in the frustum instead of " + std::to_string(linearHits));
+
+    std::vector<lustra::Ray> rays(queriesNum);
+
+    for(auto& ray : rays)
+        ray = { { distribution(random), 0.0f, -600.0f }, { 0.0f, 0.0f, 1.0f } };
+
+    std::vector<entt::entity> bvhRayHits(queriesNum), linearRayHits(queriesNum);
+
+    runner.Measure("Scene::CastRay, 20k entities", queriesNum, [&]()
+    {
+        for(uint64_t i = 0; i < queriesNum; i++)
+            bvhRayHits[i] = scene.CastRay(rays[i], 2000.0f);
+    });
+
+    runner.Measure("Linear scan, ray, 20k entities", queriesNum, [&]()
+    {
+        for(uint64_t i = 0; i < queriesNum; i++)
+        {
+            float nearest = 2000.0f, distance;
+
+            linearRayHits[i] = entt::null;
+
+            for(auto entity : view)
+            {
+                if(rays[i].Intersects(view.get<lustra::WorldBoundsComponent>(entity).bounds, nearest, distance) && distance < nearest)
+                {
+                    nearest = distance;
+                    linearRayHits[i] = entity;
+                }
+            }
+        }
+    });
+
+    runner.Check(bvhRayHits == linearRayHits, "Scene::CastRay didn't hit the nearest entity");
+}
+
+LUSTRA_BENCHMARK(SceneSerialization)
+{
+    static constexpr uint64_t iterationsNum = 10;
+
+    auto asset = std::make_shared<lustra::SceneAsset>(std::make_shared<lustra::Scene>());
+
+    CreateChains(*asset->scene, 8);
+
+    auto entitiesNum = chainsNum * 8;
+
+    for(auto extension : { ".json", ".scn" })
+    {
+        auto path = std::filesystem::temp_directory_path() / (std::string("lustra_benchmark_scene") + extension);
+        std::string format = std::string(extension) == ".json" ? "JSON" : "binary";
+
+        runner.Measure("SceneLoader::Write, " + format, iterationsNum * entitiesNum, [&]()
+        {
+            for(uint64_t i = 0; i < iterationsNum; i++)
+                lustra::SceneLoader::Get().Write(asset, path);
+        });
+
+        // Loading into an existing asset only clears its registry
+        lustra::AssetPtr loaded = std::make_shared<lustra::SceneAsset>(std::make_shared<lustra::Scene>());
+
+        runner.Measure("SceneLoader::Load, " + format, iterationsNum * entitiesNum, [&]()
+        {
+            for(uint64_t i = 0; i < iterationsNum; i++)
+                lustra::SceneLoader::Get().Load(path, loaded);
+        });
+
+        std::filesystem::remove(path);
+    }
+}
+
+LUSTRA_BENCHMARK(SceneCommands)
+{
+    static constexpr size_t entitiesNum = 10000;
+
+    lustra::Scene scene;
+
+    auto& registry = scene.GetRegistry();
+
+    runner.Measure("Entity::AddComponent, 10k entities", entitiesNum, [&]()
+    {
+        registry.clear();
+
+        for(size_t i = 0; i < entitiesNum; i++)
+        {
+            auto entity = scene.CreateEntity();
+
+            entity.AddComponent<lustra::TransformComponent>();
+            entity.AddComponent<lustra::NameComponent>("Entity");
+        }
+    });
+
+    auto& commands = scene.GetCommands();
+
+    runner.Measure("EntityCommandBuffer::AddComponent and Playback, 10k entities", entitiesNum, [&]()
+    {
+        registry.clear();
+
+        for(size_t i = 0; i < entitiesNum; i++)
+        {
+            auto entity = commands.CreateEntity();
+
+            commands.AddComponent(entity, lustra::TransformComponent());
+            commands.AddComponent(entity, lustra::NameComponent("Entity"));
+        }
+
+        commands.Playback();
+
+        lustra::FrameArena::Get().Reset();
+    });
+
+    runner.Check(registry.view<lustra::TransformComponent, lustra::NameComponent>().size_hint() == entitiesNum, "EntityCommandBuffer lost components");
+
+    // Removals and reparenting wait for the playback, clones copy the components right away
+    registry.clear();
+
+    auto parent = commands.CreateEntity();
+    auto child = commands.CreateEntity();
+
+    commands.AddComponent(parent, lustra::TransformComponent());
+    commands.AddComponent(child, lustra::NameComponent("Child"));
+    commands.ReparentEntity(child, parent);
+
+    registry.emplace<lustra::TransformComponent>(child);
+
+    auto clone = commands.CloneEntity(child);
+
+    runner.Check(registry.all_of<lustra::TransformComponent>(clone), "EntityCommandBuffer didn't copy the clone's components");
+
+    commands.AddComponent(clone, lustra::NameComponent("Clone"));
+
+    commands.RemoveComponent<lustra::TransformComponent>(parent);
+    commands.RemoveEntity(parent);
+
+    runner.Check(registry.valid(parent) && !registry.any_of<lustra::NameComponent>(child), "EntityCommandBuffer applied commands before Playback");
+
+    commands.Playback();
+
+    runner.Check(!registry.valid(parent) && commands.IsEmpty(), "EntityCommandBuffer didn't remove the entity");
+    runner.Check(scene.GetEntity("Child") == lustra::Entity(child, &scene), "EntityCommandBuffer didn't add the component");
+    runner.Check(scene.GetEntity("Clone") == lustra::Entity(clone, &scene), "EntityCommandBuffer didn't add the clone's component");
+    runner.Check(registry.any_of<lustra::HierarchyComponent>(child), "EntityCommandBuffer didn't reparent the entity");
+}
+
+LUSTRA_BENCHMARK(SceneDraw)
+{
+    static constexpr int gridSize = 32;
+    static constexpr uint64_t framesNum = 100;
+
+    lustra::Scene scene;
+    scene.SetRenderer(std::make_shared<lustra::DeferredRenderer>());
+
+    auto camera = scene.CreateEntity();
+    camera.AddComponent<lustra::TransformComponent>().SetPosition({ 0.0f, 20.0f, 60.0f });
+
+    auto& cameraComponent = camera.AddComponent<lustra::CameraComponent>();
+    cameraComponent.camera.SetViewport(lustra::Renderer::Get().GetViewportResolution());
+    cameraComponent.camera.SetPerspective();
+    cameraComponent.active = true;
+
+    auto light = scene.CreateEntity();
+    light.AddComponent<lustra::TransformComponent>().SetPosition({ 0.0f, 30.0f, 0.0f });
+
+    auto& lightComponent = light.AddComponent<lustra::LightComponent>();
+    lightComponent.shadowMap = true;
+    lightComponent.SetupShadowMap({ 1024, 1024 });
+
+    auto vertexShader = lustra::AssetManager::Get().Load<lustra::VertexShaderAsset>("vertex.vert", true);
+    auto fragmentShader = lustra::AssetManager::Get().Load<lustra::FragmentShaderAsset>("deferred.frag", true);
+
+    // Some of the cubes are behind the camera, so culling has something to do
+    for(int x = 0; x < gridSize; x++)
+    {
+        for(int z = 0; z < gridSize; z++)
+        {
+            auto entity = scene.CreateEntity();
+
+            entity.AddComponent<lustra::TransformComponent>().SetPosition({ (x - gridSize / 2) * 3.0f, 0.0f, (z - gridSize / 2) * 3.0f + 40.0f });
+            entity.AddComponent<lustra::MeshComponent>();
+            entity.AddComponent<lustra::MeshRendererComponent>();
+            entity.AddComponent<lustra::PipelineComponent>(vertexShader, fragmentShader);
+        }
+    }
+
+    // Builds the caches and the BVH, and grows the arena and the renderer's buffers
+    for(int i = 0; i < 3; i++)
+    {
+        scene.Draw();
+
+        lustra::FrameArena::Get().Reset();
+    }
+
+    runner.Measure("Scene::Draw, 1k cubes and a shadow on the Null backend", framesNum, [&]()
+    {
+        for(uint64_t i = 0; i < framesNum; i++)
+        {
+            scene.Draw();
+
+            lustra::FrameArena::Get().Reset();
+        }
+    });
+
+    runner.Check(runner.GetResults().back().allocations == 0, "Scene::Draw allocated in a steady-state frame");
+}
@@ -0,0 +1,54 @@
+#include <Benchmark.hpp>
+#include <ScriptManager.hpp>
+
+#include <fstream>
+
+namespace
+{
+
+// About the size of a typical Update in the project scripts
+constexpr const char* scriptSource = R"(
+float accumulated = 0.0f;
+
+void Update(float deltaTime)
+{
+    accumulated += deltaTime * 0.5f;
+}
+)";
+
+}
+
+LUSTRA_BENCHMARK(Scripting)
+{
+    static constexpr uint64_t callsNum = 100000;
+
+    auto path = std::filesystem::temp_directory_path() / "lustra_benchmark_script.as";
+
+    std::ofstream(path) << scriptSource;
+
+    auto script = std::make_shared<lustra::ScriptAsset>();
+    script->path = path;
+    script->modulesCount = 1;
+
+    lustra::ScriptManager::Get().AddScript(script);
+    lustra::ScriptManager::Get().Build();
+
+    runner.Measure("ScriptManager::ExecuteFunction", callsNum, [&]()
+    {
+        for(uint64_t i = 0; i < callsNum; i++)
+        {
+            lustra::ScriptManager::Get().ExecuteFunction(
+                script,
+                "void Update(float)",
+                [](auto context)
+                {
+                    context->SetArgFloat(0, 0.016f);
+                }
+            );
+        }
+    });
+
+    lustra::ScriptManager::Get().RemoveScript(script);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,80 @@
+#include <Benchmark.hpp>
+#include <TransformBatch.hpp>
+
+#include <algorithm>
+#include <random>
+
+LUSTRA_BENCHMARK(TransformKernel)
+{
+    static constexpr size_t transformsNum = 100000;
+    static constexpr uint64_t iterationsNum = 10;
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<lustra::TransformComponent> transforms(transformsNum);
+
+    // Every third transform is a root, the others hang off an earlier one
+    std::vector<size_t> parents(transformsNum);
+
+    for(size_t i = 0; i < transformsNum; i++)
+    {
+        auto& transform = transforms[i];
+
+        transform.SetPosition(glm::vec3(distribution(random), distribution(random), distribution(random)) * 10.0f);
+        transform.SetRotation(glm::normalize(glm::quat(distribution(random), distribution(random), distribution(random), distribution(random))));
+        transform.SetScale(glm::vec3(distribution(random), distribution(random), distribution(random)) * 0.25f + 1.0f);
+
+        parents[i] = i % 3 ? random() % i : i;
+    }
+
+    std::vector<glm::mat4> expected(transformsNum), worlds(transformsNum);
+
+    for(size_t i = 0; i < transformsNum; i++)
+        expected[i] = parents[i] != i ? expected[parents[i]] * transforms[i].GetTransform() : transforms[i].GetTransform();
+
+    lustra::TransformBatch batch;
+
+    for(size_t i = 0; i < transformsNum; i++)
+        batch.Add(transforms[i], parents[i] != i ? &worlds[parents[i]] : nullptr, &worlds[i]);
+
+    auto& kernel = lustra::TransformKernel::Get();
+
+    auto defaultInstructionSet = kernel.GetInstructionSet();
+
+    using InstructionSet = lustra::TransformKernel::InstructionSet;
+
+    for(auto instructionSet : { InstructionSet::Scalar, InstructionSet::SSE, InstructionSet::AVX2 })
+    {
+        if(!kernel.IsSupported(instructionSet))
+            continue;
+
+        kernel.SetInstructionSet(instructionSet);
+
+        std::string name(lustra::TransformKernel::GetName(instructionSet));
+
+        kernel.Compose(batch);
+
+        float maxError = 0.0f;
+
+        for(size_t i = 0; i < transformsNum; i++)
+            for(int column = 0; column < 4; column++)
+                for(int row = 0; row < 4; row++)
+                    maxError = std::max(
+                        maxError,
+                        std::abs(worlds[i][column][row] - expected[i][column][row]) / (1.0f + std::abs(expected[i][column][row]))
+                    );
+
+        runner.Check(maxError < 1e-4f, name + " differs from TransformComponent::GetTransform by " + std::to_string(maxError));
+
+        runner.Measure("TransformKernel::Compose, " + name, iterationsNum * transformsNum, [&]()
+        {
+            for(uint64_t i = 0; i < iterationsNum; i++)
+                kernel.Compose(batch);
+
+            lustra::DoNotOptimize(worlds.back());
+        });
+    }
+
+    kernel.SetInstructionSet(defaultInstructionSet);
+}
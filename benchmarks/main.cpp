@@ -0,0 +1,64 @@
+#include <Benchmark.hpp>
+#include <Application.hpp>
+
+#include <string_view>
+
+namespace
+{
+
+// Brings up the renderer on the Null backend and the asset loaders, so the
+// scene and asset benchmarks run without a window or a GPU
+class BenchmarkApplication : public lustra::Application
+{
+public:
+    BenchmarkApplication(const lustra::Config& config) : lustra::Application(config)
+    {
+        Init();
+    }
+
+    void Init() override
+    {
+        SetupAssetManager();
+    }
+
+    void Update(float deltaTime) override {}
+    void Render() override {}
+};
+
+}
+
+// EngineBenchmarks [--filter name] [--json results.json]
+int main(int argc, char** argv)
+{
+    std::string_view filter, jsonPath;
+
+    for(int i = 1; i + 1 < argc; i++)
+    {
+        if(std::string_view(argv[i]) == "--filter")
+            filter = argv[++i];
+        else if(std::string_view(argv[i]) == "--json")
+            jsonPath = argv[++i];
+    }
+
+    lustra::Config config;
+    config.headless = true;
+    config.configPath = std::filesystem::temp_directory_path() / "lustra_benchmark_config.json";
+
+    BenchmarkApplication application(config);
+
+    if(!lustra::Renderer::Get().IsInit())
+    {
+        LLGL::Log::Errorf(LLGL::Log::ColorFlags::StdError, "Error: The Null renderer failed to load\n");
+        return 1;
+    }
+
+    lustra::BenchmarkRunner::Get().Run(filter);
+
+    if(!jsonPath.empty() && !lustra::BenchmarkRunner::Get().WriteJson(jsonPath))
+    {
+        LLGL::Log::Errorf(LLGL::Log::ColorFlags::StdError, "Failed to write %s\n", jsonPath.data());
+        return 1;
+    }
+
+    return lustra::BenchmarkRunner::Get().GetFailedChecksNum() ? 1 : 0;
+}
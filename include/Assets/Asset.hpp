@@ -1,5 +1,7 @@
 #pragma once
 #include <Event.hpp>
+#include <CancellationToken.hpp>
+#include <MemoryUsage.hpp>
 
 #include <memory>
 #include <unordered_map>
@@ -26,11 +28,20 @@ struct Asset
     Asset(Type type) : type(type) {}
     virtual ~Asset() = default;
 
+    // Only what the asset owns, shared assets are counted by their own entries
+    virtual MemoryUsage GetMemoryUsage() const { return {}; }
+
     Type type = Type::Unknown;
 
     bool loaded = false;
 
+    // Set on the main thread before AssetLoadFailedEvent is dispatched, cleared by a reload that succeeds
+    bool failed = false;
+
     std::filesystem::path path;
+
+    // Cancelled when the asset is unloaded, stops its pending load jobs
+    CancellationToken loadToken = CancellationToken::Create();
 };
 
 using AssetPtr = std::shared_ptr<Asset>;
@@ -78,4 +89,16 @@ private:
     AssetPtr asset;
 };
 
+// A load that finished without producing the asset, a cancelled one isn't reported
+class AssetLoadFailedEvent : public Event
+{
+public:
+    AssetLoadFailedEvent(AssetPtr asset) : Event(Type::AssetLoadFailed), asset(asset) {}
+
+    AssetPtr GetAsset() const { return asset; }
+
+private:
+    AssetPtr asset;
+};
+
 }
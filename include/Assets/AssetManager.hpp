@@ -1,31 +1,129 @@
 #pragma once
 #include <AssetLoader.hpp>
 #include <Multithreading.hpp>
+#include <EventManager.hpp>
 
 #include <LLGL/Log.h>
 #include <LLGL/Texture.h>
 
+#include <coroutine>
 #include <filesystem>
+#include <map>
 #include <typeindex>
 
 namespace lustra
 {
 
-class AssetManager : public Singleton<AssetManager>
+class AssetManager : public Singleton<AssetManager>, public EventListener
 {
 public:
     using AssetStorage = std::unordered_map<std::filesystem::path, std::pair<std::type_index, AssetPtr>>;
 
+    // co_await AssetManager::Get().LoadAsync<T>(path) yields the asset once it's fully loaded.
+    // Always resumes on the main thread, so it can be awaited from a worker too.
+    // The load starts at the co_await, call Load first to overlap several of them.
+    // A load that fails or is cancelled by Unload resumes it with nullptr
+    template<class T>
+    class LoadAwaiter
+    {
+    public:
+        LoadAwaiter(
+            const std::filesystem::path& path,
+            bool relativeToAssetsDir,
+            Multithreading::JobPriority priority
+        ) : path(path), relativeToAssetsDir(relativeToAssetsDir), priority(priority) {}
+
+        bool await_ready()
+        {
+            if(!Multithreading::Get().IsMainThread())
+                return false;
+
+            asset = AssetManager::Get().Load<T>(path, relativeToAssetsDir, true, priority);
+
+            // A cached asset whose load already failed won't dispatch anything anymore
+            return !asset || asset->loaded || asset->failed;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            if(asset)
+            {
+                AssetManager::Get().AddLoadWaiter(asset, handle, &failed);
+                return;
+            }
+
+            Multithreading::Get().Schedule(
+                [this, handle]()
+                {
+                    asset = AssetManager::Get().Load<T>(path, relativeToAssetsDir, true, priority);
+
+                    if(!asset || asset->loaded || asset->failed)
+                        handle.resume();
+                    else
+                        AssetManager::Get().AddLoadWaiter(asset, handle, &failed);
+                },
+                {},
+                Multithreading::JobThread::Main,
+                priority
+            );
+        }
+
+        std::shared_ptr<T> await_resume()
+        {
+            return failed || (asset && asset->failed) ? nullptr : asset;
+        }
+
+    private:
+        std::filesystem::path path;
+
+        bool relativeToAssetsDir;
+
+        Multithreading::JobPriority priority;
+
+        std::shared_ptr<T> asset;
+
+        // Set by AssetManager before resuming
+        bool failed = false;
+    };
+
+    AssetManager()
+    {
+        EventManager::Get().AddListener(Event::Type::AssetLoaded, this);
+        EventManager::Get().AddListener(Event::Type::AssetLoadFailed, this);
+    }
+
     ~AssetManager()
     {
+        EventManager::Get().RemoveListener(Event::Type::AssetLoaded, this);
+        EventManager::Get().RemoveListener(Event::Type::AssetLoadFailed, this);
+
         StopWatch();
     }
 
+    void OnEvent(Event& event) override
+    {
+        if(event.GetType() == Event::Type::AssetLoaded)
+            ResumeLoadWaiters(static_cast<AssetLoadedEvent&>(event).GetAsset().get(), false);
+        else if(event.GetType() == Event::Type::AssetLoadFailed)
+            ResumeLoadWaiters(static_cast<AssetLoadFailedEvent&>(event).GetAsset().get(), true);
+    }
+
+    template<class T>
+    LoadAwaiter<T> LoadAsync(
+        const std::filesystem::path& path,
+        bool relativeToAssetsDir = false,
+        Multithreading::JobPriority priority = Multithreading::JobPriority::Visible
+    )
+    {
+        return { path, relativeToAssetsDir, priority };
+    }
+
     template<class T>
     std::shared_ptr<T> Load(
         const std::filesystem::path& path,
         bool relativeToAssetsDir = false,
-        bool useCache = true
+        bool useCache = true,
+        Multithreading::JobPriority priority = Multithreading::JobPriority::Visible
     )
     {
         auto assetPath = GetAssetPath<T>(path, relativeToAssetsDir);
@@ -46,7 +144,7 @@ public:
         if(!loader)
             return nullptr;
 
-        auto asset = loader->Load(assetPath);
+        auto asset = loader->Load(assetPath, nullptr, priority);
 
         if(!asset)
             return nullptr;
@@ -90,6 +188,17 @@ public:
         return assets;
     }
 
+    // Summed over the cached assets, GPU bytes are estimated by the renderer
+    std::map<Asset::Type, MemoryUsage> GetMemoryUsage() const
+    {
+        std::map<Asset::Type, MemoryUsage> usage;
+
+        for(auto& [path, asset] : assets)
+            usage[asset.second->type] += asset.second->GetMemoryUsage();
+
+        return usage;
+    }
+
     template<class T>
     void Write(std::shared_ptr<T> asset, const std::filesystem::path& path, bool relativeToAssetsDir = false)
     {
@@ -124,7 +233,17 @@ public:
     template<class T>
     void Unload(const std::filesystem::path& path)
     {
-        assets.erase(path);
+        auto it = assets.find(path);
+
+        if(it == assets.end())
+            return;
+
+        it->second.second->loadToken.Cancel();
+
+        // The cancelled jobs won't report anything
+        ResumeLoadWaiters(it->second.second.get(), true);
+
+        assets.erase(it);
 
         if(fsWatch)
             timestamps.erase(path);
@@ -174,7 +293,8 @@ public:
 
                         Multithreading::Get().AddJob({ nullptr, [&]()
                         {
-                            loader->Load(i.first, asset.second);
+                            // Someone is editing it, so it's likely on screen
+                            loader->Load(i.first, asset.second, Multithreading::JobPriority::Visible);
                         } });
 
                         timestamps[i.first] = std::filesystem::last_write_time(i.first);
@@ -194,6 +314,32 @@ public:
     }
 
 private:
+    void AddLoadWaiter(const AssetPtr& asset, std::coroutine_handle<> handle, bool* failed)
+    {
+        loadWaiters.emplace(asset.get(), LoadWaiter{ handle, failed });
+    }
+
+    // Every waiter is resumed once, a late event for the same asset finds none
+    void ResumeLoadWaiters(Asset* asset, bool failed)
+    {
+        auto [begin, end] = loadWaiters.equal_range(asset);
+
+        // Resumed through the job queue since the coroutines may add listeners
+        // while EventManager is still iterating over them
+        for(auto it = begin; it != end; it++)
+        {
+            *it->second.failed = failed;
+
+            Multithreading::Get().Schedule(
+                [handle = it->second.handle]() { handle.resume(); },
+                {},
+                Multithreading::JobThread::Main
+            );
+        }
+
+        loadWaiters.erase(begin, end);
+    }
+
     template<class T>
     AssetLoader* GetAssetLoader()
     {
@@ -225,6 +371,17 @@ private:
     
     std::unordered_map<std::type_index, std::filesystem::path> assetsRelativePaths;
     std::unordered_map<std::type_index, AssetLoader*> loaders;
+
+    struct LoadWaiter
+    {
+        std::coroutine_handle<> handle;
+
+        // Points into the suspended awaiter
+        bool* failed;
+    };
+
+    // Main thread only, the waiting coroutines keep their asset alive
+    std::unordered_multimap<Asset*, LoadWaiter> loadWaiters;
 };
 
 }
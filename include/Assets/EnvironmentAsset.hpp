@@ -1,5 +1,6 @@
 #pragma once
 #include <Asset.hpp>
+#include <Renderer.hpp>
 
 #include <LLGL/Texture.h>
 
@@ -21,6 +22,18 @@ struct EnvironmentAsset : public Asset
         prefiltered(prefiltered),
         brdf(brdf) {}
 
+    // The BRDF lookup texture is shared by every environment, so it isn't counted here
+    MemoryUsage GetMemoryUsage() const override
+    {
+        auto& renderer = Renderer::Get();
+
+        return
+        {
+            0,
+            renderer.GetResourceSize(cubeMap) + renderer.GetResourceSize(irradiance) + renderer.GetResourceSize(prefiltered)
+        };
+    }
+
     LLGL::Texture* cubeMap{};
     LLGL::Texture* irradiance{};
     LLGL::Texture* prefiltered{};
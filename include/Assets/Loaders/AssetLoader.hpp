@@ -1,6 +1,7 @@
 #pragma once
 #include <Asset.hpp>
 #include <Singleton.hpp>
+#include <Multithreading.hpp>
 
 #include <LLGL/Log.h>
 
@@ -14,7 +15,12 @@ class AssetLoader
 public:
     virtual ~AssetLoader() = default;
 
-    virtual AssetPtr Load(const std::filesystem::path& path, AssetPtr existing = nullptr) = 0;
+    // The priority goes to the jobs the load starts, lower it for assets that aren't on screen
+    virtual AssetPtr Load(
+        const std::filesystem::path& path,
+        AssetPtr existing = nullptr,
+        Multithreading::JobPriority priority = Multithreading::JobPriority::Visible
+    ) = 0;
     virtual void Write(const AssetPtr& asset, const std::filesystem::path& path) {};
     virtual void Reset() {};
 };
@@ -1,6 +1,7 @@
 #pragma once
 #include <AssetLoader.hpp>
 #include <ModelAsset.hpp>
+#include <Multithreading.hpp>
 
 #include <assimp/BaseImporter.h>
 #include <assimp/Importer.hpp>
@@ -12,24 +13,36 @@
 #include <assimp/Vertex.h>
 #include <assimp/Bitmap.h>
 
+#include <optional>
+
 namespace lustra
 {
 
 class ModelLoader : public AssetLoader, public Singleton<ModelLoader>
 {
 public:
-    AssetPtr Load(const std::filesystem::path& path, AssetPtr existing = nullptr) override;
+    AssetPtr Load(
+        const std::filesystem::path& path,
+        AssetPtr existing = nullptr,
+        Multithreading::JobPriority priority = Multithreading::JobPriority::Visible
+    ) override;
+
+    // Converts to the engine's vertex layout, the buffers are left for SetupBuffers
+    MeshPtr ProcessMesh(aiMesh* mesh, const aiScene* scene);
 
 private:
     void LoadDefaultData();
 
 private:
-    void ImportModel(const std::filesystem::path& path, ModelAssetPtr modelAsset);
-
-    void ProcessNode(aiNode* node, const aiScene* scene, ModelAssetPtr modelAsset);
+    // Returns the jobs converting every mesh of the model, nothing if assimp couldn't read the file
+    std::optional<std::vector<Multithreading::JobNodePtr>> ImportModel(
+        const std::filesystem::path& path,
+        ModelAssetPtr modelAsset,
+        Multithreading::JobPriority priority
+    );
+
+    void ProcessNode(aiNode* node, const aiScene* scene, ModelAssetPtr modelAsset, std::vector<aiMesh*>& meshes);
     void ProcessMaterial(aiMaterial* material, ModelAssetPtr modelAsset);
-    
-    MeshPtr ProcessMesh(aiMesh* mesh, const aiScene* scene);
 
 private:
     MeshPtr cube, plane;
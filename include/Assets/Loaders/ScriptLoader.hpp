@@ -8,7 +8,11 @@ namespace lustra
 class ScriptLoader : public AssetLoader, public Singleton<ScriptLoader>
 {
 public:
-    AssetPtr Load(const std::filesystem::path& path, AssetPtr existing = nullptr) override;
+    AssetPtr Load(
+        const std::filesystem::path& path,
+        AssetPtr existing = nullptr,
+        Multithreading::JobPriority priority = Multithreading::JobPriority::Visible
+    ) override;
 
 };
 
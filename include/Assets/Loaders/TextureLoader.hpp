@@ -10,7 +10,11 @@ namespace lustra
 class TextureLoader : public AssetLoader, public Singleton<TextureLoader>
 {
 public:
-    AssetPtr Load(const std::filesystem::path& path, AssetPtr existing = nullptr) override;
+    AssetPtr Load(
+        const std::filesystem::path& path,
+        AssetPtr existing = nullptr,
+        Multithreading::JobPriority priority = Multithreading::JobPriority::Visible
+    ) override;
     
     void Reset() override;
 
@@ -9,9 +9,39 @@ namespace lustra
 struct ModelAsset : public Asset
 {
     ModelAsset() : Asset(Type::Model) {};
-    ModelAsset(std::vector<MeshPtr> meshes) : Asset(Type::Model), meshes(meshes) {}
-    
+    ModelAsset(std::vector<MeshPtr> meshes) : Asset(Type::Model), meshes(meshes)
+    {
+        UpdateBounds();
+    }
+
+    // Main thread only. Counts the meshes ModelLoader handed over on the main thread,
+    // never the temporary ones its workers are still filling or the shared placeholder cube
+    MemoryUsage GetMemoryUsage() const override
+    {
+        MemoryUsage usage;
+
+        if(!loaded)
+            return usage;
+
+        for(auto& mesh : meshes)
+            usage += mesh->GetMemoryUsage();
+
+        return usage;
+    }
+
+    // Called whenever meshes changes
+    void UpdateBounds()
+    {
+        bounds = {};
+
+        for(auto& mesh : meshes)
+            bounds.Merge(mesh->GetBounds());
+    }
+
     std::vector<MeshPtr> meshes, temporaryMeshes;
+
+    // Every mesh's box merged, in model space
+    AABB bounds;
 };
 
 using ModelAssetPtr = std::shared_ptr<ModelAsset>;
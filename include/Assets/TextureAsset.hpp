@@ -1,5 +1,6 @@
 #pragma once
 #include <Asset.hpp>
+#include <Renderer.hpp>
 
 #include <LLGL/ImageFlags.h>
 #include <LLGL/Sampler.h>
@@ -30,7 +31,13 @@ struct TextureAsset : public Asset
         imageView.dataType = LLGL::DataType::UInt8;
     };
 
-    GLuint nativeHandle;
+    MemoryUsage GetMemoryUsage() const override
+    {
+        // The decoded image is only kept until it's uploaded
+        return { imageView.data ? imageView.dataSize : 0, Renderer::Get().GetResourceSize(texture) };
+    }
+
+    GLuint nativeHandle = 0;
 
     LLGL::Texture* texture{};
     LLGL::Sampler* sampler{};
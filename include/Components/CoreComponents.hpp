@@ -7,23 +7,76 @@ namespace lustra
 struct NameComponent : public ComponentBase
 {
     NameComponent() : ComponentBase("NameComponent") {}
+    NameComponent(const std::string& name) : ComponentBase("NameComponent"), name(name) {}
 
     std::string name;
 };
 
 struct TransformComponent : public ComponentBase
 {
+public:
     TransformComponent() : ComponentBase("TransformComponent") {}
 
+    void SetPosition(const glm::vec3& position);
+    void SetRotation(const glm::quat& rotation);
+    void SetScale(const glm::vec3& scale);
+
+    // Degrees, for the editor, scripts and scene files
+    void SetEulerAngles(const glm::vec3& eulerAngles);
+
+    // Expects translation, rotation and scale only, skew and perspective are dropped
+    void SetTransform(const glm::mat4& transform);
+
+    const glm::vec3& GetPosition() const;
+    const glm::quat& GetRotation() const;
+    const glm::vec3& GetScale() const;
+
+    // The angles last set if there were any, converted from the rotation otherwise
+    glm::vec3 GetEulerAngles() const;
+
+    // Recomposed only after a change, not safe to call for one component from several threads
+    const glm::mat4& GetTransform() const;
+
+    // Bumped by every change of the local transform
+    uint32_t GetVersion() const;
+
+    bool overridePhysics = false;
+
+private:
     glm::vec3 position = { 0.0f, 0.0f, 0.0f };
-    glm::vec3 rotation = { 0.0f, 0.0f, 0.0f };
+    glm::quat rotation = { 1.0f, 0.0f, 0.0f, 0.0f };
     glm::vec3 scale    = { 1.0f, 1.0f, 1.0f };
 
-    bool overridePhysics = false;
+    uint32_t version = 1;
 
-    void SetTransform(const glm::mat4& transform);
-    
-    glm::mat4 GetTransform() const;
+    mutable glm::vec3 eulerAngles = { 0.0f, 0.0f, 0.0f };
+    mutable bool eulerAnglesValid = true;
+
+    mutable glm::mat4 matrix{ 1.0f };
+    mutable uint32_t matrixVersion = 1;
+};
+
+// Cached by Scene::UpdateWorldTransforms once per frame, not serialized
+struct WorldTransformComponent : public ComponentBase
+{
+    WorldTransformComponent() : ComponentBase("WorldTransformComponent") {}
+
+    glm::mat4 transform{ 1.0f };
+
+    // For changes the local transform doesn't show, like reparenting
+    bool dirty = true;
+
+    // TransformComponent::GetVersion the cache was built from
+    uint32_t localVersion = 0;
+
+    // Bumped every time the transform is recomposed
+    uint32_t version = 0;
+
+    // Ancestors with a transform
+    uint32_t depth = 0;
+
+    // Position in the sorted hierarchy, the storage is sorted by it
+    uint32_t order = 0;
 };
 
 struct MeshComponent : public ComponentBase
@@ -35,6 +88,24 @@ struct MeshComponent : public ComponentBase
     ModelAssetPtr model;
 };
 
+// The model's box in world space, kept by Scene::UpdateBounds along with the
+// entity's leaf in the scene's BVH, not serialized
+struct WorldBoundsComponent : public ComponentBase
+{
+    WorldBoundsComponent() : ComponentBase("WorldBoundsComponent") {}
+
+    AABB bounds;
+
+    // One box per mesh of the model, what the renderer culls
+    std::vector<AABB> meshBounds;
+
+    int32_t proxy = DynamicBVH::nullNode;
+
+    // What the box was computed from
+    uint32_t worldVersion = 0;
+    AABB modelBounds;
+};
+
 struct MeshRendererComponent : public ComponentBase
 {
     MeshRendererComponent() : ComponentBase("MeshRendererComponent")
@@ -126,17 +126,30 @@ void serialize(Archive& archive, NameComponent& component)
     archive(cereal::make_nvp("name", component.name));
 }
 
+// Rotation is written as Euler degrees, like the scene files always had it
 template<class Archive>
-void serialize(Archive& archive, TransformComponent& component)
+void save(Archive& archive, const TransformComponent& component)
 {
     archive(
-        cereal::make_nvp("position", component.position),
-        cereal::make_nvp("rotation", component.rotation),
-        cereal::make_nvp("scale", component.scale),
+        cereal::make_nvp("position", component.GetPosition()),
+        cereal::make_nvp("rotation", component.GetEulerAngles()),
+        cereal::make_nvp("scale", component.GetScale()),
         cereal::make_nvp("overridePhysics", component.overridePhysics)
     );
 }
 
+template<class Archive>
+void load(Archive& archive, TransformComponent& component)
+{
+    glm::vec3 position, rotation, scale;
+
+    archive(position, rotation, scale, component.overridePhysics);
+
+    component.SetPosition(position);
+    component.SetEulerAngles(rotation);
+    component.SetScale(scale);
+}
+
 template<class Archive>
 void save(Archive& archive, const MeshComponent& component)
 {
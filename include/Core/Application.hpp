@@ -3,6 +3,7 @@
 
 #include <Timer.hpp>
 #include <Window.hpp>
+#include <HeadlessSurface.hpp>
 
 #include <Renderer.hpp>
 #include <ImGuiManager.hpp>
@@ -27,6 +28,9 @@ public:
 
     virtual void Run();
 
+    // Run returns after the current frame
+    void Quit();
+
     virtual void Init() = 0;
     virtual void Update(float deltaTime) = 0;
     virtual void Render() = 0;
@@ -34,12 +38,20 @@ public:
 protected:
     void SetupAssetManager();
 
+private:
+    bool PollEvents();
+
 protected:
     Config config;
 
     WindowPtr window;
 
     Timer deltaTimeTimer;
+
+private:
+    bool quit = false;
+
+    uint64_t framesNum = 0;
 };
 
 }
@@ -0,0 +1,131 @@
+#pragma once
+#include <glm/glm.hpp>
+
+#include <array>
+#include <limits>
+
+namespace lustra
+{
+
+// Axis-aligned box, the default one is empty and grows with Merge
+struct AABB
+{
+    AABB() = default;
+    AABB(const glm::vec3& min, const glm::vec3& max) : min(min), max(max) {}
+
+    glm::vec3 min{ std::numeric_limits<float>::max() };
+    glm::vec3 max{ std::numeric_limits<float>::lowest() };
+
+    bool IsEmpty() const
+    {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    void Merge(const glm::vec3& point)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void Merge(const AABB& other)
+    {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    AABB Merged(const AABB& other) const
+    {
+        return { glm::min(min, other.min), glm::max(max, other.max) };
+    }
+
+    AABB Expanded(float margin) const
+    {
+        return { min - margin, max + margin };
+    }
+
+    glm::vec3 GetCenter() const
+    {
+        return (min + max) * 0.5f;
+    }
+
+    // Half the size along every axis
+    glm::vec3 GetExtent() const
+    {
+        return (max - min) * 0.5f;
+    }
+
+    float GetSurfaceArea() const
+    {
+        auto size = max - min;
+
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    bool Contains(const AABB& other) const
+    {
+        return glm::all(glm::lessThanEqual(min, other.min)) && glm::all(glm::greaterThanEqual(max, other.max));
+    }
+
+    bool Intersects(const AABB& other) const
+    {
+        return glm::all(glm::lessThanEqual(min, other.max)) && glm::all(glm::greaterThanEqual(max, other.min));
+    }
+
+    bool operator==(const AABB& other) const = default;
+
+    // The box around this one transformed, not the tightest box around the transformed geometry
+    AABB Transformed(const glm::mat4& transform) const;
+};
+
+struct Sphere
+{
+    glm::vec3 center{ 0.0f };
+    float radius = 0.0f;
+
+    bool Intersects(const AABB& box) const
+    {
+        auto closest = glm::clamp(center, box.min, box.max);
+        auto offset = closest - center;
+
+        return glm::dot(offset, offset) <= radius * radius;
+    }
+};
+
+struct Ray
+{
+    glm::vec3 origin{ 0.0f };
+    glm::vec3 direction{ 0.0f, 0.0f, -1.0f };
+
+    // Slab test, distance is where the ray enters the box, zero if it starts inside
+    bool Intersects(const AABB& box, float maxDistance, float& distance) const;
+};
+
+// Six planes facing inwards, stored as (normal, distance)
+struct Frustum
+{
+    Frustum() = default;
+
+    // The planes of a projection * view matrix, the near plane assumes a [-1, 1] depth range,
+    // which only makes it looser for [0, 1]
+    Frustum(const glm::mat4& viewProjection);
+
+    enum class Result
+    {
+        Outside,
+        Intersects,
+        Inside
+    };
+
+    Result Classify(const AABB& box) const;
+
+    bool Intersects(const AABB& box) const
+    {
+        return Classify(box) != Result::Outside;
+    }
+
+    bool Intersects(const Sphere& sphere) const;
+
+    std::array<glm::vec4, 6> planes;
+};
+
+}
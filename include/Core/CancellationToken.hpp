@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <memory>
+
+namespace lustra
+{
+
+// Copies share the same state. A default-constructed token can't be cancelled
+class CancellationToken
+{
+public:
+    CancellationToken() = default;
+
+    static CancellationToken Create()
+    {
+        CancellationToken token;
+        token.cancelled = std::make_shared<std::atomic<bool>>(false);
+
+        return token;
+    }
+
+    void Cancel()
+    {
+        if(cancelled)
+            *cancelled = true;
+    }
+
+    bool IsCancelled() const
+    {
+        return cancelled && *cancelled;
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled;
+};
+
+}
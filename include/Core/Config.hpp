@@ -45,6 +45,12 @@ struct Config
 
     std::filesystem::path configPath = "config.json";
 
+    // Not saved, set from the command line: no window and LLGL's Null backend
+    bool headless = false;
+
+    // Frames to run headless before returning from Application::Run, 0 runs until Quit
+    uint64_t headlessFramesNum = 0;
+
     void Save(const std::filesystem::path& path) const
     {
         std::ofstream file(path);
@@ -0,0 +1,62 @@
+#pragma once
+#include <Multithreading.hpp>
+
+#include <LLGL/Log.h>
+
+#include <coroutine>
+#include <exception>
+
+namespace lustra
+{
+
+// Fire-and-forget coroutine: starts right away and frees itself once it returns
+struct Coroutine
+{
+    struct promise_type
+    {
+        Coroutine get_return_object() { return {}; }
+
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+
+        void unhandled_exception()
+        {
+            try
+            {
+                std::rethrow_exception(std::current_exception());
+            }
+            catch(const std::exception& exception)
+            {
+                LLGL::Log::Errorf(
+                    LLGL::Log::ColorFlags::StdError,
+                    "Coroutine failed: %s\n", exception.what()
+                );
+            }
+            catch(...)
+            {
+                LLGL::Log::Errorf(LLGL::Log::ColorFlags::StdError, "Coroutine failed\n");
+            }
+        }
+    };
+};
+
+// co_await ResumeOn(Multithreading::JobThread::Worker) moves the rest of the coroutine
+// onto the thread pool, JobThread::Main brings it back on the next Multithreading::Update
+struct ResumeOn
+{
+    Multithreading::JobThread thread;
+    Multithreading::JobPriority priority = Multithreading::JobPriority::Visible;
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) const
+    {
+        Multithreading::Get().Schedule([handle]() { handle.resume(); }, {}, thread, priority);
+    }
+
+    void await_resume() const noexcept {}
+};
+
+}
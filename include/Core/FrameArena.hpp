@@ -0,0 +1,81 @@
+#pragma once
+#include <Singleton.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace lustra
+{
+
+// Bump allocator, deallocation is a no-op and Reset frees everything at once.
+// The memory is kept between resets so a steady workload stops allocating
+class LinearArena : public std::pmr::memory_resource
+{
+public:
+    LinearArena(size_t blockSize = 64 * 1024);
+    ~LinearArena();
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    void Reset();
+
+    size_t GetUsedBytes() const;
+    size_t GetCapacity() const;
+
+    // Every block taken from the system allocator so far
+    size_t GetBlockAllocationsNum() const;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    void AddBlock(size_t size);
+    void FreeBlocks();
+
+private:
+    struct Block
+    {
+        std::byte* data = nullptr;
+        size_t size = 0;
+    };
+
+    std::vector<Block> blocks;
+
+    size_t blockSize;
+
+    size_t currentBlock = 0;
+    size_t offset = 0;
+
+    size_t usedBytes = 0;
+    size_t blockAllocationsNum = 0;
+};
+
+// Scratch memory for data that doesn't outlive the frame. Every thread allocates
+// from its own arena, so no locking happens after a thread's first allocation
+class FrameArena : public Singleton<FrameArena>
+{
+public:
+    // The calling thread's arena
+    std::pmr::memory_resource* GetResource();
+
+    // Called by the main thread at the end of the frame, when no job holds frame data anymore
+    void Reset();
+
+    size_t GetUsedBytes();
+    size_t GetBlockAllocationsNum();
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<LinearArena>> arenas;
+};
+
+template<class T>
+using FrameVector = std::pmr::vector<T>;
+
+}
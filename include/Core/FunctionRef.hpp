@@ -0,0 +1,37 @@
+#pragma once
+#include <memory>
+#include <type_traits>
+
+namespace lustra
+{
+
+template<class Signature>
+class FunctionRef;
+
+// Non-owning reference to a callable, it never allocates unlike std::function.
+// Only for parameters: the callable has to outlive the FunctionRef
+template<class Return, class... Args>
+class FunctionRef<Return(Args...)>
+{
+public:
+    template<class Function, class = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, FunctionRef>>>
+    FunctionRef(Function&& function)
+        : object(const_cast<void*>(static_cast<const void*>(std::addressof(function)))),
+          callback([](void* object, Args... args) -> Return
+          {
+              return (*static_cast<std::remove_reference_t<Function>*>(object))(std::forward<Args>(args)...);
+          })
+    {
+    }
+
+    Return operator()(Args... args) const
+    {
+        return callback(object, std::forward<Args>(args)...);
+    }
+
+private:
+    void* object;
+    Return (*callback)(void* object, Args... args);
+};
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <utility>
+
+namespace lustra
+{
+
+// Lock-free multi-producer single-consumer queue (Vyukov's intrusive
+// design with a stub node). Push from any thread, Pop from one thread only
+template<class T>
+class MPSCQueue
+{
+public:
+    MPSCQueue() : head(&stub), tail(&stub) {}
+
+    ~MPSCQueue()
+    {
+        T value;
+
+        while(Pop(value));
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    void Push(T value)
+    {
+        Push(new Node{ {}, std::move(value) });
+    }
+
+    // May return false while a producer is halfway through a Push,
+    // the value shows up on one of the next calls
+    bool Pop(T& value)
+    {
+        Node* last = tail;
+        Node* next = last->next.load(std::memory_order_acquire);
+
+        if(last == &stub)
+        {
+            if(!next)
+                return false;
+
+            tail = last = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if(next)
+        {
+            tail = next;
+
+            return Take(last, value);
+        }
+
+        if(last != head.load(std::memory_order_acquire))
+            return false;
+
+        stub.next.store(nullptr, std::memory_order_relaxed);
+        Push(&stub);
+
+        next = last->next.load(std::memory_order_acquire);
+
+        if(!next)
+            return false;
+
+        tail = next;
+
+        return Take(last, value);
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> next = nullptr;
+
+        T value;
+    };
+
+    void Push(Node* node)
+    {
+        auto previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    bool Take(Node* node, T& value)
+    {
+        value = std::move(node->value);
+
+        delete node;
+
+        return true;
+    }
+
+private:
+    Node stub;
+
+    std::atomic<Node*> head;
+    Node* tail;
+};
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace lustra
+{
+
+// Bounded lock-free multi-producer single-consumer queue (Vyukov's bounded
+// queue). Every slot is allocated up front, so pushing and popping never touch
+// the heap. Push from any thread, Pop from one thread only
+template<class T>
+class MPSCRing
+{
+public:
+    // Rounded up to a power of two
+    MPSCRing(size_t capacity)
+    {
+        size_t size = 1;
+
+        while(size < capacity)
+            size *= 2;
+
+        mask = size - 1;
+        cells = std::make_unique<Cell[]>(size);
+
+        for(size_t i = 0; i < size; i++)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MPSCRing(const MPSCRing&) = delete;
+    MPSCRing& operator=(const MPSCRing&) = delete;
+
+    // False if the ring is full, the value is only moved from on success
+    bool TryPush(T& value)
+    {
+        auto position = pushPosition.load(std::memory_order_relaxed);
+
+        Cell* cell;
+
+        while(true)
+        {
+            cell = &cells[position & mask];
+
+            auto sequence = cell->sequence.load(std::memory_order_acquire);
+            auto difference = (intptr_t)sequence - (intptr_t)position;
+
+            if(difference == 0)
+            {
+                if(pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if(difference < 0)
+                return false;
+            else
+                position = pushPosition.load(std::memory_order_relaxed);
+        }
+
+        cell->value.emplace(std::move(value));
+        cell->sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // May return false while a producer is halfway through a Push, the value shows
+    // up on one of the next calls. Optional so T doesn't have to be default constructible
+    bool Pop(std::optional<T>& value)
+    {
+        auto& cell = cells[popPosition & mask];
+
+        if(cell.sequence.load(std::memory_order_acquire) != popPosition + 1)
+            return false;
+
+        value.emplace(std::move(*cell.value));
+        cell.value.reset();
+
+        // Free for the producer that wraps around to it
+        cell.sequence.store(popPosition + mask + 1, std::memory_order_release);
+
+        popPosition++;
+
+        return true;
+    }
+
+    // Consumer side, false while a producer is halfway through a Push
+    bool IsEmpty() const
+    {
+        return pushPosition.load(std::memory_order_acquire) == popPosition;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence = 0;
+
+        std::optional<T> value;
+    };
+
+private:
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+
+    // Apart so producers and the consumer don't share a cache line
+    alignas(64) std::atomic<size_t> pushPosition = 0;
+    alignas(64) size_t popPosition = 0;
+};
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+
+namespace lustra
+{
+
+// Bytes kept in RAM and in VRAM
+struct MemoryUsage
+{
+    uint64_t cpuBytes = 0;
+    uint64_t gpuBytes = 0;
+
+    MemoryUsage& operator+=(const MemoryUsage& other)
+    {
+        cpuBytes += other.cpuBytes;
+        gpuBytes += other.gpuBytes;
+
+        return *this;
+    }
+};
+
+}
@@ -1,6 +1,11 @@
 #pragma once
 #include <Singleton.hpp>
+#include <ThreadPool.hpp>
+#include <MPSCQueue.hpp>
+#include <CancellationToken.hpp>
+#include <FrameArena.hpp>
 
+#include <tuple>
 #include <vector>
 #include <future>
 
@@ -12,18 +17,136 @@ namespace lustra
 class Multithreading : public Singleton<Multithreading>
 {
 public:
+    // { work on a worker thread, completion on the main thread }
     using Job = std::pair<std::function<void()>, std::function<void()>>;
 
+    enum class JobThread
+    {
+        Worker,
+        Main
+    };
+
+    // Mapped one to one onto ThreadPool::Priority
+    enum class JobPriority
+    {
+        Visible,
+        Prefetch,
+        Background
+    };
+
+    // What a job does when one of its dependencies failed
+    enum class DependencyFailure
+    {
+        // Skip the work and count as failed too, so the failure reaches the whole subgraph
+        Skip,
+        // Run anyway, for jobs that clean up or report the failure by checking IsFailed on their dependencies
+        Run
+    };
+
+    // A node of the job graph, it runs once every dependency has finished
+    class JobNode
+    {
+    public:
+        bool IsFinished() const { return finished; }
+
+        // The work threw, or was skipped because a dependency failed. Final once IsFinished
+        bool IsFailed() const { return failed; }
+
+    private:
+        std::function<void()> work;
+
+        JobThread thread = JobThread::Worker;
+        JobPriority priority = JobPriority::Visible;
+
+        CancellationToken token;
+
+        DependencyFailure onDependencyFailure = DependencyFailure::Skip;
+
+        std::atomic<size_t> remainingDependencies = 0;
+        std::atomic<bool> finished = false;
+        std::atomic<bool> failed = false;
+        std::atomic<bool> dependencyFailed = false;
+
+        std::mutex mutex;
+        std::vector<std::shared_ptr<JobNode>> successors;
+
+    private:
+        friend class Multithreading;
+    };
+
+    using JobNodePtr = std::shared_ptr<JobNode>;
+
     void Update();
 
     void AddJob(const Job& job);
 
+    // Fan-in through several dependencies, fan-out by depending on the same node.
+    // A cancelled job skips its work but still releases its successors, a job that throws
+    // fails and its successors act on it as onDependencyFailure says
+    JobNodePtr Schedule(
+        std::function<void()> work,
+        const std::vector<JobNodePtr>& dependencies = {},
+        JobThread thread = JobThread::Worker,
+        JobPriority priority = JobPriority::Visible,
+        const CancellationToken& token = {},
+        DependencyFailure onDependencyFailure = DependencyFailure::Skip
+    );
+
+    // Splits [0, count) into chunks of grainSize and runs them on the pool,
+    // the calling thread takes chunks too and returns once all are done.
+    // Chunks are fixed by index, so writing results by index is deterministic
+    void ParallelFor(
+        size_t count,
+        const std::function<void(size_t begin, size_t end)>& function,
+        size_t grainSize = 64
+    );
+
+    // Calls function(entity, components...) for every entity of an entt view.
+    // The view must not be structurally modified while it runs
+    template<class View, class Function>
+    void ParallelEach(const View& view, Function&& function, size_t grainSize = 64)
+    {
+        FrameVector<std::decay_t<decltype(*view.begin())>> entities(view.begin(), view.end(), FrameArena::Get().GetResource());
+
+        ParallelFor(
+            entities.size(),
+            [&](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                    std::apply(function, std::tuple_cat(std::make_tuple(entities[i]), view.get(entities[i])));
+            },
+            grainSize
+        );
+    }
+
+    // Main-thread jobs past the budget spill into the next frame, zero disables the limit
+    void SetFrameBudget(std::chrono::microseconds budget);
+
+    std::chrono::microseconds GetFrameBudget() const;
+
     size_t GetJobsNum() const;
 
+    // The main thread is the one calling Update, false until the first Update
+    bool IsMainThread() const;
+
 private:
-    using ManagedJob = std::pair<std::future<void>, std::function<void()>>;
+    void Dispatch(JobNodePtr node);
+    void Run(const JobNodePtr& node);
+
+    bool PopMainThreadJob(JobNodePtr& node);
+
+private:
+    std::atomic<size_t> jobsNum = 0;
+    std::atomic<size_t> mainThreadJobsNum = 0;
+
+    std::chrono::microseconds frameBudget = 4000us;
+
+    std::atomic<std::thread::id> mainThreadId;
+
+    std::array<MPSCQueue<JobNodePtr>, ThreadPool::prioritiesNum> mainThreadJobs;
 
-    std::vector<ManagedJob> jobs;
+    // Declared last so the workers are joined before the queues go away
+    ThreadPool threadPool;
 };
 
 }
@@ -0,0 +1,139 @@
+#pragma once
+#include <Singleton.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lustra
+{
+
+// Collects named, nested CPU zones from every thread. Each thread writes into its own
+// ring buffer without locking, the main thread drains them on every frame marker and
+// keeps the events while a capture is running
+class Profiler : public Singleton<Profiler>
+{
+public:
+    struct ZoneEvent
+    {
+        const char* name = nullptr; // Must outlive the profiler, string literals are fine
+
+        uint64_t begin = 0; // Nanoseconds since the profiler was created
+        uint64_t end = 0;
+
+        uint32_t depth = 0;
+    };
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
+    // Shown in the trace instead of the thread index
+    void SetThreadName(const std::string& name);
+
+    // Called by the main thread once per frame
+    void MarkFrame();
+
+    void StartCapture();
+
+    // Writes everything captured since StartCapture as Chrome trace JSON
+    // (chrome://tracing, ui.perfetto.dev), false if the file couldn't be written
+    bool StopCapture(const std::filesystem::path& path);
+
+    bool IsCapturing() const;
+
+    // Zones lost because a ring buffer was full
+    uint64_t GetDroppedZonesNum() const;
+
+    uint64_t GetTimestamp() const;
+
+    // Used by ProfilerZone
+    void BeginZone();
+    void EndZone(const char* name, uint64_t begin);
+
+private:
+    Profiler();
+
+    friend class Singleton<Profiler>;
+
+private:
+    static constexpr size_t ringBufferSize = 1 << 13;
+
+    // Single producer (the owning thread), single consumer (Collect)
+    struct ThreadBuffer
+    {
+        std::array<ZoneEvent, ringBufferSize> events;
+
+        std::atomic<uint64_t> head = 0;
+        std::atomic<uint64_t> tail = 0;
+
+        uint32_t index = 0;
+        uint32_t depth = 0;
+
+        std::string name;
+    };
+
+    struct CapturedZone
+    {
+        ZoneEvent event;
+
+        uint32_t threadIndex = 0;
+    };
+
+    ThreadBuffer& GetThreadBuffer();
+
+    void Collect();
+
+private:
+    std::chrono::steady_clock::time_point start;
+
+    std::atomic<bool> enabled = true;
+    std::atomic<bool> capturing = false;
+
+    std::atomic<uint64_t> droppedZonesNum = 0;
+
+    std::mutex mutex;
+
+    std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+    std::vector<CapturedZone> capturedZones;
+    std::vector<uint64_t> capturedFrames;
+};
+
+// Records the time between its construction and destruction as a zone
+class ProfilerZone
+{
+public:
+    ProfilerZone(const char* name);
+    ~ProfilerZone();
+
+    ProfilerZone(const ProfilerZone&) = delete;
+    ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+private:
+    const char* name;
+
+    uint64_t begin = 0;
+
+    bool active = false;
+};
+
+}
+
+#define LUSTRA_PROFILER_CONCAT_IMPL(a, b) a##b
+#define LUSTRA_PROFILER_CONCAT(a, b) LUSTRA_PROFILER_CONCAT_IMPL(a, b)
+
+#ifdef LUSTRA_PROFILER
+    #define LUSTRA_PROFILE_ZONE(name) ::lustra::ProfilerZone LUSTRA_PROFILER_CONCAT(profilerZone, __LINE__)(name)
+    #define LUSTRA_PROFILE_FUNCTION() LUSTRA_PROFILE_ZONE(__func__)
+    #define LUSTRA_PROFILE_FRAME() ::lustra::Profiler::Get().MarkFrame()
+#else
+    #define LUSTRA_PROFILE_ZONE(name)
+    #define LUSTRA_PROFILE_FUNCTION()
+    #define LUSTRA_PROFILE_FRAME()
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lustra
+{
+
+// Fixed-size pool, every worker owns a deque per priority: it pops its own
+// tasks from the back and steals from the front of the other workers' deques
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    enum class Priority
+    {
+        High,
+        Normal,
+        Low
+    };
+
+    static constexpr size_t prioritiesNum = 3;
+
+    ThreadPool(size_t workersNum = GetDefaultWorkersNum());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(Task task, Priority priority = Priority::Normal);
+
+    size_t GetWorkersNum() const;
+
+    static size_t GetDefaultWorkersNum();
+
+private:
+    struct Worker
+    {
+        std::thread thread;
+
+        std::mutex mutex;
+        std::array<std::deque<Task>, prioritiesNum> tasks;
+    };
+
+    void WorkerLoop(size_t index);
+
+    // Higher priorities are taken from every worker before lower ones
+    bool Pop(size_t index, Task& task);
+    bool PopLocal(size_t index, size_t priority, Task& task);
+    bool Steal(size_t index, size_t priority, Task& task);
+
+private:
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::atomic<bool> running = true;
+    std::atomic<size_t> pendingTasks = 0;
+    std::atomic<size_t> nextWorker = 0;
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
+#include <Profiler.hpp>
+
 #include <chrono>
-#include <string_view>
 
 #include <LLGL/Log.h>
 
@@ -21,16 +22,22 @@ private:
     std::chrono::high_resolution_clock::time_point start;
 };
 
+// Logs the elapsed time and, with the profiler compiled in, records it as a zone
 class ScopedTimer
 {
 public:
-    ScopedTimer(std::string_view name);
+    // The profiler keeps the pointer until the trace is exported, pass a string literal
+    ScopedTimer(const char* name);
     ~ScopedTimer();
 
 private:
     Timer timer;
 
-    std::string_view name;
+    const char* name;
+
+#ifdef LUSTRA_PROFILER
+    ProfilerZone zone;
+#endif
 };
 
 }
@@ -52,6 +52,7 @@ private:
     void DrawImGuizmoControls();
     void DrawImGuizmo();
     void DrawExecutionControl();
+    void DrawMemoryUsage();
 
     void DrawLog();
 
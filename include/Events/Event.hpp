@@ -13,6 +13,7 @@ public:
         WindowResize,
         WindowFocus,
         AssetLoaded,
+        AssetLoadFailed,
         Collision
     };
 
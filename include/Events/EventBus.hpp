@@ -0,0 +1,194 @@
+#pragma once
+#include <Singleton.hpp>
+#include <MPSCRing.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace lustra
+{
+
+// Statically typed counterpart of EventManager for high-volume events. Every event type
+// gets its own listener list and a preallocated lock-free ring, events are dispatched from
+// a buffer that keeps its capacity between flushes and listeners are called without any casts
+class EventBus : public Singleton<EventBus>
+{
+public:
+    // Never destroyed, like the channels, so singletons that remove their
+    // listeners from their destructors can't outlive it
+    static EventBus& Get()
+    {
+        static auto instance = new EventBus();
+        return *instance;
+    }
+
+    // The listener needs an OnEvent(T&) overload
+    template<class T, class Listener>
+    void AddListener(Listener* listener)
+    {
+        auto& listeners = GetChannel<T>().listeners;
+
+        auto found = std::find_if(listeners.begin(), listeners.end(), [&](const auto& delegate)
+        {
+            return delegate.instance == listener;
+        });
+
+        if(found != listeners.end())
+            return;
+
+        listeners.push_back({
+            listener,
+            [](void* instance, T& event) { static_cast<Listener*>(instance)->OnEvent(event); }
+        });
+    }
+
+    template<class T>
+    void RemoveListener(void* listener)
+    {
+        auto& listeners = GetChannel<T>().listeners;
+
+        listeners.erase(
+            std::remove_if(listeners.begin(), listeners.end(), [&](const auto& delegate)
+            {
+                return delegate.instance == listener;
+            }),
+            listeners.end()
+        );
+    }
+
+    // Main thread only, stops at the first listener that handles the event
+    template<class T>
+    void Dispatch(T& event)
+    {
+        GetChannel<T>().Dispatch(event);
+    }
+
+    // Can be called from any thread, like from Jolt's contact callbacks. It doesn't lock or
+    // allocate unless more events than the ring holds are posted between flushes.
+    // The event is dispatched by the next Flush
+    template<class T>
+    void Post(T event)
+    {
+        GetChannel<T>().Post(event);
+    }
+
+    // Main thread only, events posted by the listeners wait for the next call
+    template<class T>
+    void Flush()
+    {
+        GetChannel<T>().Flush();
+    }
+
+    // Flushes every event type in the order they were first used
+    void Flush();
+
+private:
+    class ChannelBase
+    {
+    public:
+        virtual ~ChannelBase() = default;
+
+        virtual void Flush() = 0;
+    };
+
+    template<class T>
+    class Channel : public ChannelBase
+    {
+    public:
+        struct Delegate
+        {
+            void* instance;
+            void (*callback)(void* instance, T& event);
+        };
+
+        Channel()
+        {
+            EventBus::Get().AddChannel(this);
+        }
+
+        void Post(T& event)
+        {
+            if(!overflowing.load(std::memory_order_acquire) && pending.TryPush(event))
+                return;
+
+            // The ring is full. Everything posted until the next Flush goes here too, so each
+            // thread's events keep their order. The vector keeps its capacity between flushes
+            std::lock_guard lock(overflowMutex);
+
+            overflowing.store(true, std::memory_order_release);
+            overflow.push_back(std::move(event));
+        }
+
+        void Dispatch(T& event)
+        {
+            // By index since a listener may add other listeners
+            for(size_t i = 0; i < listeners.size(); i++)
+            {
+                listeners[i].callback(listeners[i].instance, event);
+
+                if(event.IsHandled())
+                    break;
+            }
+        }
+
+        void Flush() override
+        {
+            // An event whose Push is still in progress waits for the next Flush
+            std::optional<T> posted;
+
+            while(pending.Pop(posted))
+                dispatching.push_back(std::move(*posted));
+
+            // Unless a Push is still in progress, the ring is empty and every
+            // event that overflowed came after the ones dispatched from it
+            if(overflowing.load(std::memory_order_acquire) && pending.IsEmpty())
+            {
+                std::lock_guard lock(overflowMutex);
+
+                std::move(overflow.begin(), overflow.end(), std::back_inserter(dispatching));
+                overflow.clear();
+
+                overflowing.store(false, std::memory_order_release);
+            }
+
+            for(auto& event : dispatching)
+                Dispatch(event);
+
+            dispatching.clear();
+        }
+
+    public:
+        std::vector<Delegate> listeners;
+
+        // Events posted between two flushes before Post falls back to the locked overflow
+        static constexpr size_t capacity = 4096;
+
+        MPSCRing<T> pending{ capacity };
+
+        std::mutex overflowMutex;
+        std::atomic<bool> overflowing = false;
+        std::vector<T> overflow;
+
+        std::vector<T> dispatching;
+    };
+
+    // Leaked on purpose, see Get
+    template<class T>
+    static Channel<T>& GetChannel()
+    {
+        static auto channel = new Channel<T>();
+        return *channel;
+    }
+
+    void AddChannel(ChannelBase* channel);
+
+private:
+    std::mutex channelsMutex;
+    std::vector<ChannelBase*> channels;
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <EventListener.hpp>
 #include <Singleton.hpp>
+#include <MPSCQueue.hpp>
 
 #include <memory>
 #include <unordered_map>
@@ -15,10 +16,28 @@ public:
     void AddListener(Event::Type eventType, EventListener* listener);
     void RemoveListener(Event::Type eventType, EventListener* listener);
 
+    // Main thread only, calls the listeners right away
     void Dispatch(std::unique_ptr<Event> event);
 
+    // Can be called from any thread, the event is dispatched by the next Flush.
+    // Of several coalesced events of the same type only the last one is dispatched
+    void Post(std::unique_ptr<Event> event, bool coalesce = false);
+
+    // Dispatches everything posted so far, events posted by the listeners wait for the next call
+    void Flush();
+
+private:
+    struct PostedEvent
+    {
+        std::unique_ptr<Event> event;
+
+        bool coalesce = false;
+    };
+
 private:
     std::unordered_map<Event::Type, std::vector<EventListener*>> listeners;
+
+    MPSCQueue<PostedEvent> postedEvents;
 };
 
 }
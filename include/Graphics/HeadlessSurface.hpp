@@ -0,0 +1,25 @@
+#pragma once
+#include <LLGL/Surface.h>
+
+namespace lustra
+{
+
+// Stands in for the window when rendering with the Null backend, so the swap chain
+// and everything sized after it still get a resolution
+class HeadlessSurface : public LLGL::Surface
+{
+public:
+    HeadlessSurface(const LLGL::Extent2D& size);
+
+public: // Interface implementation
+    bool GetNativeHandle(void* nativeHandle, size_t size) override;
+    bool AdaptForVideoMode(LLGL::Extent2D* resolution, bool* fullscreen) override;
+
+    LLGL::Extent2D GetContentSize() const override;
+    LLGL::Display* FindResidentDisplay() const override;
+
+private:
+    LLGL::Extent2D size;
+};
+
+}
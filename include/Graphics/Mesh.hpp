@@ -1,5 +1,7 @@
 #pragma once
 #include <Utils.hpp>
+#include <MemoryUsage.hpp>
+#include <Bounds.hpp>
 
 namespace lustra
 {
@@ -17,6 +19,9 @@ public:
     Mesh() = default;
     Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, bool setupBuffers = true);
 
+    // For boxes that come with the data, like the ones assimp generates
+    Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const AABB& bounds, bool setupBuffers = true);
+
     void SetupBuffers();
 
     void CreateCube();
@@ -29,10 +34,18 @@ public:
     std::vector<Vertex> GetVertices() const;
     std::vector<uint32_t> GetIndices() const;
 
+    // In model space
+    const AABB& GetBounds() const;
+
+    // The vertices and indices are kept on the CPU after upload for colliders and reloading
+    MemoryUsage GetMemoryUsage() const;
+
 private:
     void CreateVertexBuffer();
     void CreateIndexBuffer();
 
+    void ComputeBounds();
+
 private:
     LLGL::VertexFormat vertexFormat;
 
@@ -42,6 +55,8 @@ private:
 
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
+
+    AABB bounds;
 };
 
 using MeshPtr = std::shared_ptr<Mesh>;
@@ -0,0 +1,79 @@
+#pragma once
+#include <LLGL/RenderTarget.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace lustra
+{
+
+struct RenderStats
+{
+    uint64_t renderPasses = 0;
+    uint64_t drawCalls = 0;
+    uint64_t pipelineBinds = 0;
+    uint64_t resourceBinds = 0;
+    uint64_t bufferUpdateBytes = 0;
+    uint64_t textureUploads = 0;
+    uint64_t submits = 0;
+
+    // Meshes tested against the frustum before their draws were recorded
+    uint64_t meshesVisible = 0;
+    uint64_t meshesCulled = 0;
+
+    RenderStats& operator+=(const RenderStats& other)
+    {
+        renderPasses += other.renderPasses;
+        drawCalls += other.drawCalls;
+        pipelineBinds += other.pipelineBinds;
+        resourceBinds += other.resourceBinds;
+        bufferUpdateBytes += other.bufferUpdateBytes;
+        textureUploads += other.textureUploads;
+        submits += other.submits;
+        meshesVisible += other.meshesVisible;
+        meshesCulled += other.meshesCulled;
+
+        return *this;
+    }
+};
+
+// Everything currently allocated through Renderer::CreateTexture and CreateBuffer
+struct GpuMemoryStats
+{
+    uint64_t textureBytes = 0;
+    uint64_t bufferBytes = 0;
+
+    uint64_t texturesNum = 0;
+    uint64_t buffersNum = 0;
+};
+
+// Everything recorded between two Renderer::Present calls
+struct FrameStats
+{
+    uint64_t frame = 0;
+
+    RenderStats total;
+
+    // Passes, draws, binds and buffer updates by render target, nullptr is the swap chain
+    std::vector<std::pair<const LLGL::RenderTarget*, RenderStats>> renderTargets;
+
+    RenderStats& GetRenderTargetStats(const LLGL::RenderTarget* renderTarget)
+    {
+        for(auto& [target, stats] : renderTargets)
+            if(target == renderTarget)
+                return stats;
+
+        return renderTargets.emplace_back(renderTarget, RenderStats{}).second;
+    }
+
+    void Clear()
+    {
+        total = {};
+
+        // Keeps the capacity so a steady frame doesn't allocate
+        renderTargets.clear();
+    }
+};
+
+}
@@ -1,11 +1,14 @@
 #pragma once
 #include <Utils.hpp>
 #include <Singleton.hpp>
+#include <FunctionRef.hpp>
+#include <RenderStats.hpp>
 
 #include <LLGL/Surface.h>
 
 #include <filesystem>
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <unordered_map>
 
@@ -15,7 +18,7 @@ namespace lustra
 class Renderer : public Singleton<Renderer>
 {
 public: // Public methods
-    void Init();
+    void Init(const std::string& module = "OpenGL"); // "Null" renders nothing, for headless runs
 
     void InitSwapChain(const LLGL::Extent2D& resolution, bool fullscreen = false, int samples = 1);
     void InitSwapChain(std::shared_ptr<LLGL::Surface> surface);
@@ -23,10 +26,22 @@ public: // Public methods
     void Begin(); // Start writing to the command buffer
     void End(); // End writing to the command buffer
 
+    using CommandFunction = FunctionRef<void(LLGL::CommandBuffer*)>;
+    using ResourceBinding = std::pair<const uint32_t, LLGL::Resource*>;
+
+    // Nothing is allocated here, so this is the one to use for per-draw passes
+    void RenderPass(
+        CommandFunction setupBuffers, // Set vert/ind/static buffers with CommandBuffer
+        std::initializer_list<ResourceBinding> resources, // A list of resources { binding, Resource_ptr }
+        CommandFunction draw, // Call the draw function
+        LLGL::PipelineState* pipeline,
+        LLGL::RenderTarget* renderTarget = nullptr
+    );
+
     void RenderPass(
-        std::function<void(LLGL::CommandBuffer*)> setupBuffers, // Set vert/ind/static buffers with CommandBuffer
+        CommandFunction setupBuffers,
         const std::unordered_map<uint32_t, LLGL::Resource*>& resources, // A map of resources { binding, Resource_ptr }
-        std::function<void(LLGL::CommandBuffer*)> draw, // Call the draw function
+        CommandFunction draw,
         LLGL::PipelineState* pipeline,
         LLGL::RenderTarget* renderTarget = nullptr
     );
@@ -42,6 +57,8 @@ public: // Public methods
     template<class T>
     void Release(T* resource)
     {
+        UntrackResource(resource);
+
         renderSystem->Release(*resource);
     }
 
@@ -73,6 +90,26 @@ public: // Public methods
 
     bool IsInit(); // Will return false if RenderSystem init failed
 
+    // Draws and buffer updates go straight to the command buffer, so they're reported here
+    void CountDrawCall();
+    void CountBufferUpdate(uint64_t bytes);
+
+    // Culling happens before any pass is recorded, so the target is given explicitly
+    void CountCulling(const LLGL::RenderTarget* renderTarget, uint64_t visible, uint64_t culled);
+
+    // The last presented frame
+    const FrameStats& GetFrameStats() const;
+
+    // Writes the kept frames as CSV, a "total" row and a row per render target for every frame
+    bool WriteFrameStatsCsv(const std::filesystem::path& path) const;
+
+    void SetFrameStatsHistorySize(size_t size);
+
+    // Estimated from the descriptors, mip chains included. 0 for untracked resources
+    uint64_t GetResourceSize(const void* resource) const;
+
+    const GpuMemoryStats& GetGpuMemoryStats() const;
+
 private: // Singleton-related
     Renderer();
 
@@ -87,9 +124,37 @@ private: // Private methods
 
     void SetupBuffers();
 
+    void TrackResource(const void* resource, uint64_t size, bool texture);
+    void UntrackResource(const void* resource);
+
+    void ExecuteRenderPass(
+        CommandFunction setupBuffers,
+        CommandFunction setResources,
+        CommandFunction draw,
+        LLGL::PipelineState* pipeline,
+        LLGL::RenderTarget* renderTarget
+    );
+
 private: // Private members
     uint64_t renderPassCounter = 0;
 
+    FrameStats frameStats;
+    const LLGL::RenderTarget* currentRenderTarget = nullptr;
+
+    // Ring buffer of the last presented frames
+    std::vector<FrameStats> frameStatsHistory;
+    size_t frameStatsHistorySize = 600;
+    size_t frameStatsHistoryNext = 0;
+
+    struct TrackedResource
+    {
+        uint64_t size = 0;
+        bool texture = false;
+    };
+
+    GpuMemoryStats gpuMemoryStats;
+    std::unordered_map<const void*, TrackedResource> trackedResources;
+
     LLGL::Extent2D viewportResolution;
 
     LLGL::RenderSystemPtr renderSystem;
@@ -13,12 +13,19 @@ inline void DrawComponentUI(NameComponent& component, entt::entity entity)
 
 inline void DrawComponentUI(TransformComponent& component, entt::entity entity)
 {
-    ImGui::DragFloat3("Position", &component.position.x, 0.05f);
-    ImGui::DragFloat3("Rotation", &component.rotation.x, 0.05f);
-    ImGui::DragFloat3("Scale", &component.scale.x, 0.01f);
+    auto position = component.GetPosition();
+    auto rotation = component.GetEulerAngles();
+    auto scale = component.GetScale();
+
+    if(ImGui::DragFloat3("Position", &position.x, 0.05f))
+        component.SetPosition(position);
+    if(ImGui::DragFloat3("Rotation", &rotation.x, 0.05f))
+        component.SetEulerAngles(rotation);
+    if(ImGui::DragFloat3("Scale", &scale.x, 0.01f))
+        component.SetScale(scale);
 
     if(ImGui::Button("Reset Scale"))
-        component.scale = glm::vec3(1.0f);
+        component.SetScale(glm::vec3(1.0f));
 
     ImGui::Checkbox("Override physics", &component.overridePhysics);
 }
@@ -603,7 +610,15 @@ void DrawEntityUI(entt::registry& registry, entt::entity entity)
         if constexpr (HasComponentUI<Component>::value)
             if(ImGui::CollapsingHeader(component->componentName.data()))
             {
+                ImGui::BeginGroup();
+
                 DrawComponentUI(*component, entity);
+
+                ImGui::EndGroup();
+
+                // Edits are made in place, the patch lets on_update listeners like the name index see them
+                if(ImGui::IsItemEdited())
+                    registry.patch<Component>(entity);
                 
                 ImGui::PushID(component->componentName.data());
 
@@ -10,5 +10,6 @@ public:
     void Render() override;
 
 private:
-
+    std::shared_ptr<lustra::DeferredRenderer> deferredRenderer;
+    std::shared_ptr<lustra::Scene> scene;
 };
@@ -0,0 +1,39 @@
+#pragma once
+#include <JoltInclude.hpp>
+
+#include <mutex>
+
+namespace lustra
+{
+
+// Remembers the bodies that fell asleep, their last pose still has to reach their entities
+class ActivationListener : public JPH::BodyActivationListener
+{
+public:
+    virtual void OnBodyActivated(const JPH::BodyID& bodyId, JPH::uint64 userData) override {}
+
+    // Called from Jolt's worker threads during the step, or from RemoveBody
+    virtual void OnBodyDeactivated(const JPH::BodyID& bodyId, JPH::uint64 userData) override
+    {
+        std::lock_guard lock(mutex);
+
+        deactivatedBodies.push_back(bodyId);
+    }
+
+    // Appends the bodies deactivated since the last call
+    void TakeDeactivatedBodies(JPH::BodyIDVector& bodies)
+    {
+        std::lock_guard lock(mutex);
+
+        bodies.insert(bodies.end(), deactivatedBodies.begin(), deactivatedBodies.end());
+
+        deactivatedBodies.clear();
+    }
+
+private:
+    std::mutex mutex;
+
+    JPH::BodyIDVector deactivatedBodies;
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <JoltInclude.hpp>
 #include <EventManager.hpp>
+#include <EventBus.hpp>
 
 #include <glm/vec3.hpp>
 
@@ -78,8 +79,9 @@ private:
         const JPH::ContactManifold& manifold
     )
     {
-        EventManager::Get().Dispatch(
-            std::make_unique<CollisionEvent>(
+        // Called from Jolt's worker threads, the event is dispatched on the main thread after the physics step
+        EventBus::Get().Post(
+            CollisionEvent(
                 const_cast<JPH::Body*>(&body1),
                 const_cast<JPH::Body*>(&body2),
                 manifold
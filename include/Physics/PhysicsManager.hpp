@@ -4,6 +4,7 @@
 #include <LayerFilters.hpp>
 #include <BroadPhaseLayer.hpp>
 #include <CollisionListener.hpp>
+#include <ActivationListener.hpp>
 
 namespace lustra
 {
@@ -24,8 +25,12 @@ public:
     JPH::PhysicsSystem& GetPhysicsSystem();
     JPH::BodyInterface& GetBodyInterface();
 
+    // Appends the bodies that fell asleep since the last call, they're no longer in GetActiveBodies
+    void TakeDeactivatedBodies(JPH::BodyIDVector& bodies);
+
 private:
     std::unique_ptr<CollisionListener> collisionListener;
+    std::unique_ptr<ActivationListener> activationListener;
     std::unique_ptr<JPH::JobSystemThreadPool> jobSystem;
     std::unique_ptr<JPH::TempAllocatorImpl> tempAllocator;
 
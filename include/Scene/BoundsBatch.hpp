@@ -0,0 +1,58 @@
+#pragma once
+#include <Bounds.hpp>
+#include <TransformBatch.hpp>
+
+namespace lustra
+{
+
+// World boxes stored one array per component, like TransformBatch
+struct BoundsBatch
+{
+    BoundsBatch(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Not for empty boxes. The default AABB's extent overflows to -inf, a plane with a zero
+    // component turns it into NaN and the box passes the test
+    void Add(const AABB& bounds);
+
+    void Reserve(size_t size);
+    void Clear();
+
+    size_t GetSize() const;
+
+    FrameVector<float> minX, minY, minZ;
+    FrameVector<float> maxX, maxY, maxZ;
+};
+
+class CullingKernel : public Singleton<CullingKernel>
+{
+public:
+    using InstructionSet = TransformKernel::InstructionSet;
+
+    // Writes 1 to visible[i] for every box in [begin, end) the frustum intersects, 0 otherwise,
+    // and returns how many are visible. Disjoint ranges can be culled from several threads
+    size_t Cull(const Frustum& frustum, const BoundsBatch& batch, size_t begin, size_t end, uint8_t* visible) const;
+
+    size_t Cull(const Frustum& frustum, const BoundsBatch& batch, uint8_t* visible) const;
+
+    // Picked like TransformKernel's, switching is meant for benchmarks
+    void SetInstructionSet(InstructionSet instructionSet);
+
+    InstructionSet GetInstructionSet() const;
+
+    bool IsSupported(InstructionSet instructionSet) const;
+
+private:
+    CullingKernel();
+
+    friend class Singleton<CullingKernel>;
+
+private:
+    using CullFunction = size_t(*)(const Frustum& frustum, const BoundsBatch& batch, size_t begin, size_t end, uint8_t* visible);
+
+    InstructionSet instructionSet = InstructionSet::Scalar;
+    InstructionSet bestInstructionSet = InstructionSet::Scalar;
+
+    CullFunction cull;
+};
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <Bounds.hpp>
+#include <FunctionRef.hpp>
+
+#include <entt/entt.hpp>
+
+#include <vector>
+
+namespace lustra
+{
+
+// Bounding volume tree that is updated in place as entities move. Leaves store
+// their box grown by a margin, so a small move doesn't touch the tree, and a leaf
+// that leaves its box is reinserted. Rotations keep the tree balanced
+class DynamicBVH
+{
+public:
+    static constexpr int32_t nullNode = -1;
+
+    DynamicBVH(float margin = 0.1f);
+
+    // Returns the proxy that identifies the leaf
+    int32_t Insert(const AABB& bounds, entt::entity entity);
+
+    void Remove(int32_t proxy);
+
+    // True if the leaf had to be reinserted
+    bool Move(int32_t proxy, const AABB& bounds);
+
+    void Clear();
+
+    // Every entity whose fat box touches the volume, may report a few more than the exact boxes would
+    void Query(const AABB& box, FunctionRef<void(entt::entity)> callback) const;
+    void Query(const Sphere& sphere, FunctionRef<void(entt::entity)> callback) const;
+    void Query(const Frustum& frustum, FunctionRef<void(entt::entity)> callback) const;
+
+    // Visits the leaves the ray hits within maxDistance, nearest subtrees first. The callback
+    // returns the new maximum distance: the hit distance to clip the ray, zero to stop, or
+    // the current maximum to keep going
+    void CastRay(const Ray& ray, float maxDistance, FunctionRef<float(entt::entity, float)> callback) const;
+
+    const AABB& GetFatBounds(int32_t proxy) const;
+    entt::entity GetEntity(int32_t proxy) const;
+
+    size_t GetProxiesNum() const;
+    int32_t GetHeight() const;
+
+private:
+    struct Node
+    {
+        AABB bounds;
+
+        // The next free node while the node is unused
+        int32_t parent = nullNode;
+
+        int32_t left = nullNode;
+        int32_t right = nullNode;
+
+        // Leaves are at zero, free nodes at -1
+        int32_t height = 0;
+
+        entt::entity entity = entt::null;
+
+        bool IsLeaf() const { return left == nullNode; }
+    };
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t node);
+
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+
+    // Rotates the subtree if its children's heights differ by more than one, returns its new root
+    int32_t Balance(int32_t node);
+
+    // Reports every leaf below the node without testing them
+    void ReportSubtree(int32_t node, FunctionRef<void(entt::entity)> callback) const;
+
+private:
+    std::vector<Node> nodes;
+
+    int32_t root = nullNode;
+    int32_t freeList = nullNode;
+
+    size_t proxiesNum = 0;
+
+    float margin;
+};
+
+}
@@ -73,6 +73,11 @@ public:
         return entity;
     }
 
+    Scene* GetScene() const
+    {
+        return scene;
+    }
+
 private:
     entt::entity entity{ entt::null };
 
@@ -0,0 +1,199 @@
+#pragma once
+#include <FrameArena.hpp>
+
+#include <entt/entt.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace lustra
+{
+
+class Scene;
+
+// Structural changes recorded while the registry is iterated, or read by systems
+// running in parallel, and applied in one batch at a sync point. Removals, reparenting
+// and component changes can be recorded from any thread. Creating and cloning entities
+// changes the entity storage right away, so it's limited to the thread owning the scene.
+// Playback must not overlap with anything using the registry
+class EntityCommandBuffer
+{
+public:
+    // Called by the thread owning the scene, the only one allowed to create entities
+    EntityCommandBuffer(Scene* scene);
+
+    // The id is taken right away so later commands can refer to it. entt allows creating
+    // entities while a view is iterated, but not while another thread reads the registry
+    entt::entity CreateEntity();
+
+    // Copies the components right away, like Scene::CloneEntity, under the same rule as CreateEntity
+    entt::entity CloneEntity(entt::entity entity);
+
+    void RemoveEntity(entt::entity entity);
+    void ReparentEntity(entt::entity child, entt::entity parent);
+
+    // Adding a component the entity already has replaces it
+    template<class T>
+    void AddComponent(entt::entity entity, T component)
+    {
+        std::lock_guard lock(mutex);
+
+        auto& commands = GetComponentCommands<T>();
+
+        commands.entities.push_back(entity);
+        commands.values.emplace_back(std::move(component));
+    }
+
+    template<class T>
+    void RemoveComponent(entt::entity entity)
+    {
+        std::lock_guard lock(mutex);
+
+        auto& commands = GetComponentCommands<T>();
+
+        commands.entities.push_back(entity);
+        commands.values.emplace_back(std::nullopt);
+    }
+
+    // Component changes first, in the order they were recorded per type, with runs of adds
+    // inserted in bulk. Then reparenting and removals.
+    // Commands on entities removed in the meantime are dropped
+    void Playback();
+
+    bool IsEmpty();
+
+private:
+    struct ComponentCommandsBase
+    {
+        virtual ~ComponentCommandsBase() = default;
+
+        virtual void Playback(entt::registry& registry) = 0;
+
+        virtual bool IsEmpty() const = 0;
+    };
+
+    template<class T>
+    struct ComponentCommands : ComponentCommandsBase
+    {
+        void Playback(entt::registry& registry) override
+        {
+            size_t runBegin = 0;
+
+            for(size_t i = 0; i <= values.size(); i++)
+            {
+                if(i < values.size() && values[i])
+                    continue;
+
+                // A removal ends the run of adds before it
+                InsertRun(registry, runBegin, i);
+
+                if(i < values.size() && registry.valid(entities[i]))
+                    registry.remove<T>(entities[i]);
+
+                runBegin = i + 1;
+            }
+
+            // Cleared rather than freed, the capacity is reused next frame
+            entities.clear();
+            values.clear();
+        }
+
+        void InsertRun(entt::registry& registry, size_t begin, size_t end)
+        {
+            auto resource = FrameArena::Get().GetResource();
+
+            auto& storage = registry.storage<T>();
+
+            FrameVector<uint32_t> added(resource);
+
+            for(size_t i = begin; i < end; i++)
+            {
+                if(!registry.valid(entities[i]))
+                    continue;
+
+                if(storage.contains(entities[i]))
+                    registry.replace<T>(entities[i], std::move(*values[i]));
+                else
+                    added.push_back(i);
+            }
+
+            // The same entity twice in a run keeps the last value
+            std::stable_sort(added.begin(), added.end(), [&](auto a, auto b)
+            {
+                return entities[a] < entities[b];
+            });
+
+            FrameVector<entt::entity> addedEntities(resource);
+            FrameVector<T> addedValues(resource);
+
+            addedEntities.reserve(added.size());
+            addedValues.reserve(added.size());
+
+            for(size_t i = 0; i < added.size(); i++)
+            {
+                if(i + 1 < added.size() && entities[added[i]] == entities[added[i + 1]])
+                    continue;
+
+                addedEntities.push_back(entities[added[i]]);
+                addedValues.push_back(std::move(*values[added[i]]));
+            }
+
+            registry.insert<T>(addedEntities.begin(), addedEntities.end(), addedValues.begin());
+        }
+
+        bool IsEmpty() const override
+        {
+            return entities.empty();
+        }
+
+        std::vector<entt::entity> entities;
+
+        // No value is a removal
+        std::vector<std::optional<T>> values;
+    };
+
+    template<class T>
+    ComponentCommands<T>& GetComponentCommands()
+    {
+        auto& commands = componentCommandsByType[entt::type_hash<T>::value()];
+
+        if(!commands)
+            commands = componentCommands.emplace_back(std::make_unique<ComponentCommands<T>>()).get();
+
+        return static_cast<ComponentCommands<T>&>(*commands);
+    }
+
+private:
+    struct EntityCommand
+    {
+        enum class Type
+        {
+            Reparent,
+            Remove
+        };
+
+        Type type;
+
+        entt::entity entity, other;
+    };
+
+    Scene* scene;
+
+    std::thread::id ownerThread;
+
+    std::mutex mutex;
+
+    std::vector<EntityCommand> entityCommands;
+
+    // Kept in the order the types were first used so playback is deterministic
+    std::vector<std::unique_ptr<ComponentCommandsBase>> componentCommands;
+    std::unordered_map<entt::id_type, ComponentCommandsBase*> componentCommandsByType;
+};
+
+}
@@ -4,13 +4,19 @@
 #include <DeferredRenderer.hpp>
 #include <AssetManager.hpp>
 #include <InputManager.hpp>
+#include <BoundsBatch.hpp>
+#include <SystemScheduler.hpp>
+#include <EntityCommandBuffer.hpp>
 
 #include <entt/entt.hpp>
 
+#include <unordered_map>
+
 namespace lustra
 {
 
 class Entity;
+class CollisionEvent;
 
 class Scene : public EventListener
 {
@@ -28,6 +34,7 @@ public:
     void Draw(LLGL::RenderTarget* renderTarget = Renderer::Get().GetSwapChain());
 
     void OnEvent(Event& event) override;
+    void OnEvent(CollisionEvent& event);
 
     void SetUpdatePhysics(bool updatePhysics);
     void ToggleUpdatePhysics();
@@ -43,13 +50,71 @@ public:
     Entity GetEntity(entt::id_type id);
     Entity GetEntity(const std::string& name); // Not using std::string_view since this function is used by Angelscript
 
+    // Every entity with the name, both lookups go through the name index
+    std::vector<Entity> GetEntities(const std::string& name);
+
+    // Patches the NameComponent so the name index sees the change
+    void RenameEntity(Entity entity, const std::string& name);
+
     bool IsChildOf(Entity child, Entity parent);
 
+    // Walks the parent chain, so it's up to date even mid-frame.
+    // Rendering reads the WorldTransformComponent cache instead
     glm::mat4 GetWorldTransform(entt::entity entity);
 
+    // Recomposes the cached world transforms of the subtrees whose local transform
+    // changed since the last call, called by Draw
+    void UpdateWorldTransforms();
+
+    // Moves the world boxes of the entities with a mesh and their leaves in the BVH,
+    // called by Draw after the world transforms
+    void UpdateBounds();
+
+    // Entities whose world bounds touch the volume, as of the last UpdateBounds
+    void QueryBounds(const AABB& box, FunctionRef<void(entt::entity)> callback);
+    void QueryBounds(const Sphere& sphere, FunctionRef<void(entt::entity)> callback);
+    void QueryBounds(const Frustum& frustum, FunctionRef<void(entt::entity)> callback);
+
+    // The entity whose world bounds the ray enters first, entt::null if there is none
+    entt::entity CastRay(const Ray& ray, float maxDistance, float* distance = nullptr);
+
+    const DynamicBVH& GetBVH() const;
+
+    // Neither of these goes through AssetManager
+    MemoryUsage GetShadowMapsMemoryUsage();
+    MemoryUsage GetEnvironmentsMemoryUsage();
+
     entt::registry& GetRegistry();
 
+    // Run by Update after the built-in ones, scheduled by what they declare to access
+    SystemScheduler& GetSystems();
+
+    // Structural changes from scripts and systems, played back after the scripts
+    // and at the end of Update and Start
+    EntityCommandBuffer& GetCommands();
+
 private:
+    // Registers what Update and Draw run every frame
+    void SetupSystems();
+
+    // Moves the bodies of the entities that override physics, before the step
+    void PushPhysicsTransforms();
+
+    // Copies the bodies that are awake after the step into their entities' transforms
+    void SyncPhysicsTransforms();
+
+    void OnRigidBodyChanged(entt::registry& registry, entt::entity entity);
+
+    void SortHierarchy();
+
+    void OnWorldTransformChanged(entt::registry& registry, entt::entity entity);
+
+    void OnNameChanged(entt::registry& registry, entt::entity entity);
+    void OnNameRemoved(entt::registry& registry, entt::entity entity);
+
+    void OnBoundsCreated(entt::registry& registry, entt::entity entity);
+    void OnBoundsRemoved(entt::registry& registry, entt::entity entity);
+
     void SetupLightsBuffer();
     void SetupShadowsBuffer();
     void UpdateLightsBuffer();
@@ -59,19 +124,40 @@ private:
     void SetupLights();
     void SetupShadows();
 
-    void RenderMeshes();
-    void RenderToShadowMap();
+    // From the light's world transform, shared by the shadow pass and the shading
+    glm::mat4 GetLightView(entt::entity light, const TransformComponent& transform);
+
+    // One entry per mesh of every drawn model, gathered once a frame and culled by every pass
+    struct DrawList
+    {
+        DrawList(std::pmr::memory_resource* resource);
+
+        FrameVector<entt::entity> entities;
+        FrameVector<uint32_t> meshes;
+
+        BoundsBatch bounds;
+    };
+
+    void GatherDrawList(DrawList& drawList);
+
+    // Flags the entries the frustum intersects, returns how many it does
+    size_t CullDrawList(const DrawList& drawList, const Frustum& frustum, FrameVector<uint8_t>& visible);
+
+    void RenderMeshes(const DrawList& drawList);
+    void RenderToShadowMap(const DrawList& drawList);
     void RenderSky(LLGL::RenderTarget* renderTarget);
 
     void MeshRenderPass(
         const MeshComponent& mesh,
         const MeshRendererComponent& meshRenderer,
         const PipelineComponent& pipeline,
+        size_t meshIndex,
         LLGL::RenderTarget* renderTarget
     );
     void ShadowRenderPass(
         const LightComponent& light,
-        const MeshComponent& mesh
+        const MeshComponent& mesh,
+        size_t meshIndex
     );
     void ProceduralSkyRenderPass(
         const MeshComponent& mesh,
@@ -135,6 +221,37 @@ private:
 private:
     entt::registry registry{};
 
+private:
+    static constexpr uint32_t noHierarchyParent = ~0u;
+
+    bool hierarchyChanged = true;
+
+    // Entities with a transform, parents first, and the index of each one's parent
+    std::vector<entt::entity> hierarchyOrder;
+    std::vector<uint32_t> hierarchyParents;
+
+private:
+    // Entities by name, and the name each one is indexed under
+    std::unordered_map<std::string, std::vector<entt::entity>> nameIndex;
+    std::unordered_map<entt::entity, std::string> indexedNames;
+
+private:
+    DynamicBVH bvh;
+
+private:
+    bool rigidBodiesChanged = true;
+
+    // Filled by SyncPhysicsTransforms every step, kept for its capacity
+    JPH::BodyIDVector activeBodies;
+
+private:
+    SystemScheduler updateSystems;
+
+    // Camera, lights and shadows are short, running them in place keeps Draw from allocating jobs
+    SystemScheduler drawSystems{ false };
+
+    EntityCommandBuffer commands{ this };
+
 private:
     friend class Entity;
 };
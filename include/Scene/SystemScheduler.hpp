@@ -0,0 +1,112 @@
+#pragma once
+#include <entt/entt.hpp>
+
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace lustra
+{
+
+// Per-frame work with the data it touches declared up front. The types can be
+// components or anything else that's shared, like a singleton or a buffer
+class System
+{
+public:
+    using Function = std::function<void(float deltaTime)>;
+
+    // The name has to outlive the profiler, string literals are fine
+    System(const char* name, Function function);
+
+    template<class... Types>
+    System& Reads()
+    {
+        (reads.push_back(entt::type_hash<Types>::value()), ...);
+
+        return *this;
+    }
+
+    template<class... Types>
+    System& Writes()
+    {
+        (writes.push_back(entt::type_hash<Types>::value()), ...);
+
+        return *this;
+    }
+
+    // Conflicts with every other system, for code that can touch anything, like scripts
+    System& Exclusive();
+
+    // Runs on the thread calling SystemScheduler::Update instead of the job pool
+    System& OnMainThread();
+
+    // One of the two writes something the other reads or writes
+    bool ConflictsWith(const System& other) const;
+
+    const char* GetName() const;
+
+private:
+    const char* name;
+
+    Function function;
+
+    std::vector<entt::id_type> reads, writes;
+
+    bool exclusive = false;
+    bool mainThread = false;
+
+private:
+    friend class SystemScheduler;
+};
+
+// Runs every system once per Update. Systems that conflict run in the order they
+// were added, the others run at the same time on the job pool and on the thread
+// calling Update, which takes ready systems itself instead of waiting for the pool.
+// Systems must not change the registry's structure directly, they record it in an EntityCommandBuffer
+class SystemScheduler
+{
+public:
+    // Without the job pool every system runs on the thread calling Update, in dependency order.
+    // For a few short systems, where handing them to the pool costs more than it saves
+    // and allocates a job per system
+    SystemScheduler(bool useJobPool = true);
+    ~SystemScheduler();
+
+    // Declare the access on the returned system right away, it's read on the next Update
+    System& AddSystem(const char* name, System::Function function);
+
+    void RemoveSystem(std::string_view name);
+
+    void Clear();
+
+    // Returns once every system has run
+    void Update(float deltaTime);
+
+    size_t GetSystemsNum() const;
+
+private:
+    struct State;
+
+    // Queues a system whose dependencies have all finished
+    void Dispatch(uint32_t index);
+
+    void Run(uint32_t index);
+
+    // A ready system for the thread calling Update, false if there is none
+    bool PopReadyMain(uint32_t& index);
+
+    // Pops one ready system that may run on any thread, false if there is none
+    static bool RunReadyWorker(State& state);
+
+private:
+    // Stable addresses, so AddSystem can hand out references
+    std::vector<std::unique_ptr<System>> systems;
+
+    bool useJobPool = true;
+
+    // Shared with the pool's helper jobs, which may start after Update returned
+    std::shared_ptr<State> state;
+};
+
+}
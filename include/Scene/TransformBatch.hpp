@@ -0,0 +1,72 @@
+#pragma once
+#include <CoreComponents.hpp>
+#include <FrameArena.hpp>
+#include <Singleton.hpp>
+
+#include <string_view>
+
+namespace lustra
+{
+
+// Local transforms stored one array per component, so the kernel
+// loads the same component of several entities with one instruction
+struct TransformBatch
+{
+    TransformBatch(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // *output = *parent * local, without a parent the local matrix is written as is
+    void Add(const TransformComponent& transform, const glm::mat4* parent, glm::mat4* output);
+
+    void Reserve(size_t size);
+    void Clear();
+
+    size_t GetSize() const;
+
+    FrameVector<float> positionX, positionY, positionZ;
+    FrameVector<float> rotationX, rotationY, rotationZ, rotationW;
+    FrameVector<float> scaleX, scaleY, scaleZ;
+
+    FrameVector<const glm::mat4*> parents;
+    FrameVector<glm::mat4*> outputs;
+};
+
+class TransformKernel : public Singleton<TransformKernel>
+{
+public:
+    enum class InstructionSet
+    {
+        Scalar,
+        SSE,
+        AVX2
+    };
+
+    // Same result as *parent * TransformComponent::GetTransform() for every entry in [begin, end).
+    // Disjoint ranges can be composed from several threads
+    void Compose(const TransformBatch& batch, size_t begin, size_t end) const;
+
+    void Compose(const TransformBatch& batch) const;
+
+    // The best supported one is picked on startup, switching is meant for benchmarks
+    void SetInstructionSet(InstructionSet instructionSet);
+
+    InstructionSet GetInstructionSet() const;
+
+    bool IsSupported(InstructionSet instructionSet) const;
+
+    static std::string_view GetName(InstructionSet instructionSet);
+
+private:
+    TransformKernel();
+
+    friend class Singleton<TransformKernel>;
+
+private:
+    using ComposeFunction = void(*)(const TransformBatch& batch, size_t begin, size_t end);
+
+    InstructionSet instructionSet = InstructionSet::Scalar;
+    InstructionSet bestInstructionSet = InstructionSet::Scalar;
+
+    ComposeFunction compose;
+};
+
+}
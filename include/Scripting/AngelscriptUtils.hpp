@@ -295,6 +295,24 @@ inline glm::mat4 GetWorldTransform(Entity entity, Scene* scene)
     return scene->GetWorldTransform(entity);
 }
 
+// Scripts run while the engine iterates the registry. entt allows creating entities and adding
+// components meanwhile, so CreateEntity and CloneEntity stay immediate, removals are deferred
+inline void RemoveEntity(Entity entity, Scene* scene)
+{
+    scene->GetCommands().RemoveEntity(entity);
+}
+
+inline void ReparentEntity(Entity child, Entity parent, Scene* scene)
+{
+    scene->GetCommands().ReparentEntity(child, parent);
+}
+
+template<class T>
+inline void RemoveComponent(Entity* entity)
+{
+    entity->GetScene()->GetCommands().RemoveComponent<T>(*entity);
+}
+
 inline RayCastResult CastRay(const glm::vec3& origin, const glm::vec3& direction)
 {
     JPH::RayCastResult result;
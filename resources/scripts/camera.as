@@ -20,7 +20,7 @@ void Update(float deltaTime)
     {
         Mouse::SetCursorVisible(false);
 
-        auto rotation = glm::quat(glm::radians(transform.rotation));
+        auto rotation = transform.rotation;
 
         glm::vec3 input = glm::vec3(0.0f);
 
@@ -44,15 +44,19 @@ void Update(float deltaTime)
             currentSpeed = glm::mix(currentSpeed, 0.0f, lerpSpeed);
 
         if(currentSpeed > 0.0f)
-            transform.position += glm::normalize(movement) * deltaTime * currentSpeed;
+            transform.position = transform.position + glm::normalize(movement) * deltaTime * currentSpeed;
 
         glm::vec2 center(960, 540);
         glm::vec2 delta = center - Mouse::GetPosition();
 
-        transform.rotation.x += delta.y / 100.0f;
-        transform.rotation.y += delta.x / 100.0f;
+        glm::vec3 eulerAngles = transform.eulerAngles;
 
-        transform.rotation.x = glm::clamp(transform.rotation.x, -89.0f, 89.0f);
+        eulerAngles.x += delta.y / 100.0f;
+        eulerAngles.y += delta.x / 100.0f;
+
+        eulerAngles.x = glm::clamp(eulerAngles.x, -89.0f, 89.0f);
+
+        transform.eulerAngles = eulerAngles;
 
         Mouse::SetPosition(center);
     }
@@ -11,5 +11,9 @@ void Start()
 void Update(float deltaTime)
 {
     transform.overridePhysics = true;
-    transform.rotation.y += 5.0f * deltaTime;
+
+    glm::vec3 eulerAngles = transform.eulerAngles;
+    eulerAngles.y += 5.0f * deltaTime;
+
+    transform.eulerAngles = eulerAngles;
 }
@@ -27,7 +27,7 @@ void Start()
 void Update(float deltaTime)
 {
     if(InputManager::IsActionPressed("Up"))
-        transform.position.y += 1.0f * deltaTime;
+        transform.position = transform.position + glm::vec3(0.0f, 1.0f * deltaTime, 0.0f);
 }
 
 void OnWindowResize(WindowResizeEvent@ event)
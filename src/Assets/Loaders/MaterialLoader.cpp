@@ -3,6 +3,7 @@
 #include <Serialize.hpp>
 #include <MaterialLoader.hpp>
 #include <AssetManager.hpp>
+#include <Profiler.hpp>
 #include <EventManager.hpp>
 
 #include <fstream>
@@ -10,8 +11,14 @@
 namespace lustra
 {
 
-AssetPtr MaterialLoader::Load(const std::filesystem::path& path, AssetPtr existing)
+AssetPtr MaterialLoader::Load(
+    const std::filesystem::path& path,
+    AssetPtr existing,
+    Multithreading::JobPriority priority
+)
 {
+    LUSTRA_PROFILE_ZONE("MaterialLoader::Load");
+
     if(!defaultMaterial)
         LoadDefaultData();
     
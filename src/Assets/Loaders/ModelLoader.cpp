@@ -1,11 +1,18 @@
 #include <ModelLoader.hpp>
 #include <Multithreading.hpp>
 #include <EventManager.hpp>
+#include <Profiler.hpp>
+
+#include <algorithm>
 
 namespace lustra
 {
 
-AssetPtr ModelLoader::Load(const std::filesystem::path& path, AssetPtr existing)
+AssetPtr ModelLoader::Load(
+    const std::filesystem::path& path,
+    AssetPtr existing,
+    Multithreading::JobPriority priority
+)
 {
     if(!plane)
         LoadDefaultData();
@@ -16,42 +23,77 @@ AssetPtr ModelLoader::Load(const std::filesystem::path& path, AssetPtr existing)
         path.string().c_str()
     );
 
-    if(path.filename() == "plane")
-        return std::make_shared<ModelAsset>(ModelAsset({ plane }));
-    if(path.filename() == "cube")
-        return std::make_shared<ModelAsset>(ModelAsset({ cube }));
+    if(path.filename() == "plane" || path.filename() == "cube")
+    {
+        auto builtinAsset = std::make_shared<ModelAsset>(ModelAsset({ path.filename() == "plane" ? plane : cube }));
+        builtinAsset->loaded = true;
+
+        return builtinAsset;
+    }
 
     auto modelAsset = existing
         ? std::static_pointer_cast<ModelAsset>(existing)
         : std::make_shared<ModelAsset>(ModelAsset({ cube }));
 
-    auto load = [path, modelAsset, this]()
+    auto create = [path, modelAsset](const std::optional<std::vector<Multithreading::JobNodePtr>>& meshJobs)
     {
-        ImportModel(path, modelAsset);
-    };
+        LUSTRA_PROFILE_ZONE("ModelLoader::SetupBuffers");
+
+        // The import failed, or a mesh job that threw left a null mesh behind
+        bool failed = !meshJobs || std::any_of(meshJobs->begin(), meshJobs->end(), [](const auto& job)
+        {
+            return job->IsFailed();
+        });
+
+        if(failed)
+        {
+            modelAsset->temporaryMeshes.clear();
+            modelAsset->failed = true;
+
+            EventManager::Get().Dispatch(std::make_unique<AssetLoadFailedEvent>(modelAsset));
+
+            return;
+        }
 
-    auto create = [modelAsset]()
-    {
         modelAsset->meshes = modelAsset->temporaryMeshes;
         modelAsset->temporaryMeshes.clear();
+        modelAsset->UpdateBounds();
 
         for(auto& mesh : modelAsset->meshes)
             mesh->SetupBuffers();
 
+        LLGL::Log::Printf(
+            LLGL::Log::ColorFlags::Bold | LLGL::Log::ColorFlags::Green,
+            "Model \"%s\" loaded.\n",
+            path.string().c_str()
+        );
+
         modelAsset->loaded = true;
+        modelAsset->failed = false;
 
         EventManager::Get().Dispatch(std::make_unique<AssetLoadedEvent>(modelAsset));
     };
 
-    if(true) // Add a "separateThread" parameter
-    {
-        Multithreading::Get().AddJob({ load, create });
-    }
-    else
-    {
-        load();
-        create();
-    }
+    // Import -> every mesh in parallel -> buffers on the main thread
+    Multithreading::Get().Schedule(
+        [path, modelAsset, create, priority, this]()
+        {
+            auto meshJobs = ImportModel(path, modelAsset, priority);
+
+            Multithreading::Get().Schedule(
+                [create, meshJobs]() { create(meshJobs); },
+                meshJobs.value_or(std::vector<Multithreading::JobNodePtr>{}),
+                Multithreading::JobThread::Main,
+                priority,
+                modelAsset->loadToken,
+                Multithreading::DependencyFailure::Run
+            );
+        },
+        {},
+        Multithreading::JobThread::Worker,
+        priority,
+        modelAsset->loadToken
+    );
    
     return modelAsset;
 }
@@ -62,47 +104,69 @@ void ModelLoader::LoadDefaultData()
     (cube = std::make_shared<Mesh>())->CreateCube();
 }
 
-void ModelLoader::ImportModel(const std::filesystem::path& path, ModelAssetPtr modelAsset)
+std::optional<std::vector<Multithreading::JobNodePtr>> ModelLoader::ImportModel(
+    const std::filesystem::path& path,
+    ModelAssetPtr modelAsset,
+    Multithreading::JobPriority priority
+)
 {
+    LUSTRA_PROFILE_ZONE("ModelLoader::ImportModel");
+
     auto flags = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenBoundingBoxes | aiProcess_LimitBoneWeights;
 
-    Assimp::Importer importer;
-    importer.SetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS, 1);
+    // Shared with the mesh jobs, the scene is owned by the importer
+    auto importer = std::make_shared<Assimp::Importer>();
+    importer->SetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS, 1);
 
-    auto scene = importer.ReadFile(path.string(), flags);
+    auto scene = importer->ReadFile(path.string(), flags);
 
     if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
     {
         LLGL::Log::Errorf(
             LLGL::Log::ColorFlags::StdError,
-            "Failed to load model: %s\n", importer.GetErrorString()
+            "Failed to load model: %s\n", importer->GetErrorString()
         );
 
-        return;
+        return std::nullopt;
     }
 
-    modelAsset->meshes.reserve(scene->mNumMeshes);
-    modelAsset->temporaryMeshes.reserve(scene->mNumMeshes);
+    std::vector<aiMesh*> meshes;
+    meshes.reserve(scene->mNumMeshes);
 
-    ProcessNode(scene->mRootNode, scene, modelAsset);
+    ProcessNode(scene->mRootNode, scene, modelAsset, meshes);
 
-    LLGL::Log::Printf(
-        LLGL::Log::ColorFlags::Bold | LLGL::Log::ColorFlags::Green,
-        "Model \"%s\" loaded.\n",
-        path.string().c_str()
-    );
+    modelAsset->temporaryMeshes.resize(meshes.size());
+
+    std::vector<Multithreading::JobNodePtr> meshJobs;
+    meshJobs.reserve(meshes.size());
+
+    for(size_t i = 0; i < meshes.size(); i++)
+    {
+        meshJobs.push_back(Multithreading::Get().Schedule(
+            [importer, scene, mesh = meshes[i], i, modelAsset, this]()
+            {
+                modelAsset->temporaryMeshes[i] = ProcessMesh(mesh, scene);
+            },
+            {},
+            Multithreading::JobThread::Worker,
+            priority,
+            modelAsset->loadToken
+        ));
+    }
+
+    return meshJobs;
 }
 
-void ModelLoader::ProcessNode(aiNode* node, const aiScene* scene, std::shared_ptr<ModelAsset> modelAsset)
+void ModelLoader::ProcessNode(aiNode* node, const aiScene* scene, std::shared_ptr<ModelAsset> modelAsset, std::vector<aiMesh*>& meshes)
 {
     for(uint32_t i = 0; i < node->mNumMeshes; i++)
-        modelAsset->temporaryMeshes.push_back(ProcessMesh(scene->mMeshes[node->mMeshes[i]], scene));
+        meshes.push_back(scene->mMeshes[node->mMeshes[i]]);
 
     for(unsigned int i = 0; i < scene->mNumMaterials; i++)
         ProcessMaterial(scene->mMaterials[i], modelAsset);
 
     for(uint32_t i = 0; i < node->mNumChildren; i++)
-        ProcessNode(node->mChildren[i], scene, modelAsset);
+        ProcessNode(node->mChildren[i], scene, modelAsset, meshes);
 }
 
 void ModelLoader::ProcessMaterial(aiMaterial* material, std::shared_ptr<ModelAsset> modelAsset)
@@ -112,6 +176,8 @@ void ModelLoader::ProcessMaterial(aiMaterial* material, std::shared_ptr<ModelAss
 
 MeshPtr ModelLoader::ProcessMesh(aiMesh* mesh, const aiScene* scene)
 {
+    LUSTRA_PROFILE_ZONE("ModelLoader::ProcessMesh");
+
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
 
@@ -138,7 +204,13 @@ MeshPtr ModelLoader::ProcessMesh(aiMesh* mesh, const aiScene* scene)
             indices.push_back(face.mIndices[j]);
     }
     
-    return std::make_shared<Mesh>(vertices, indices, false);
+    // Generated by aiProcess_GenBoundingBoxes
+    AABB bounds(
+        { mesh->mAABB.mMin.x, mesh->mAABB.mMin.y, mesh->mAABB.mMin.z },
+        { mesh->mAABB.mMax.x, mesh->mAABB.mMax.y, mesh->mAABB.mMax.z }
+    );
+
+    return std::make_shared<Mesh>(vertices, indices, bounds, false);
 }
 
 }
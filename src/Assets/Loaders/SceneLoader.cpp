@@ -1,5 +1,6 @@
 #include <Serialize.hpp>
 #include <SceneLoader.hpp>
+#include <Profiler.hpp>
 
 #include <cereal/types/string.hpp>
 #include <cereal/archives/json.hpp>
@@ -10,8 +11,14 @@
 namespace lustra
 {
 
-AssetPtr SceneLoader::Load(const std::filesystem::path& path, AssetPtr existing)
+AssetPtr SceneLoader::Load(
+    const std::filesystem::path& path,
+    AssetPtr existing,
+    Multithreading::JobPriority priority
+)
 {
+    LUSTRA_PROFILE_ZONE("SceneLoader::Load");
+
     auto asset = existing
         ? std::static_pointer_cast<SceneAsset>(existing)
         : std::make_shared<SceneAsset>(std::make_shared<Scene>());
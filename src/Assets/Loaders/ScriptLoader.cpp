@@ -1,11 +1,18 @@
 #include <ScriptLoader.hpp>
 #include <EventManager.hpp>
+#include <Profiler.hpp>
 
 namespace lustra
 {
 
-AssetPtr ScriptLoader::Load(const std::filesystem::path& path, AssetPtr existing)
+AssetPtr ScriptLoader::Load(
+    const std::filesystem::path& path,
+    AssetPtr existing,
+    Multithreading::JobPriority priority
+)
 {
+    LUSTRA_PROFILE_ZONE("ScriptLoader::Load");
+
     auto asset = existing
         ? std::static_pointer_cast<ScriptAsset>(existing)
         : std::make_shared<ScriptAsset>();
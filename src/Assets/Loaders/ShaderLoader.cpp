@@ -1,11 +1,18 @@
 #include <ShaderLoader.hpp>
 #include <EventManager.hpp>
+#include <Profiler.hpp>
 
 namespace lustra
 {
 
-AssetPtr VertexShaderLoader::Load(const std::filesystem::path& path, AssetPtr existing)
+AssetPtr VertexShaderLoader::Load(
+    const std::filesystem::path& path,
+    AssetPtr existing,
+    Multithreading::JobPriority priority
+)
 {
+    LUSTRA_PROFILE_ZONE("VertexShaderLoader::Load");
+
     auto shader = Renderer::Get().CreateShader(LLGL::ShaderType::Vertex, path);
     
     auto asset = existing
@@ -25,8 +32,14 @@ AssetPtr VertexShaderLoader::Load(const std::filesystem::path& path, AssetPtr ex
     return asset;
 }
 
-AssetPtr FragmentShaderLoader::Load(const std::filesystem::path& path, AssetPtr existing)
+AssetPtr FragmentShaderLoader::Load(
+    const std::filesystem::path& path,
+    AssetPtr existing,
+    Multithreading::JobPriority priority
+)
 {
+    LUSTRA_PROFILE_ZONE("FragmentShaderLoader::Load");
+
     auto shader = Renderer::Get().CreateShader(LLGL::ShaderType::Fragment, path);
 
     auto asset = existing
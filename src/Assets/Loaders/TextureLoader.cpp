@@ -1,5 +1,6 @@
 #include <TextureLoader.hpp>
 #include <EventManager.hpp>
+#include <Profiler.hpp>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
@@ -7,7 +8,11 @@
 namespace lustra
 {
 
-AssetPtr TextureLoader::Load(const std::filesystem::path& path, AssetPtr existing)
+AssetPtr TextureLoader::Load(
+    const std::filesystem::path& path,
+    AssetPtr existing,
+    Multithreading::JobPriority priority
+)
 {
     if(!defaultTexture)
         LoadDefaultData();
@@ -31,6 +36,8 @@ AssetPtr TextureLoader::Load(const std::filesystem::path& path, AssetPtr existin
 
     auto loadUint = [textureAsset, path]()
     {
+        LUSTRA_PROFILE_ZONE("TextureLoader::Decode");
+
         int width, height, channels;
         unsigned char* data = stbi_load(path.string().c_str(), &width, &height, &channels, 4);
 
@@ -50,13 +57,15 @@ AssetPtr TextureLoader::Load(const std::filesystem::path& path, AssetPtr existin
 
     auto loadFloat = [textureAsset, path]()
     {
+        LUSTRA_PROFILE_ZONE("TextureLoader::Decode");
+
         int width, height, channels;
         float* data = stbi_loadf(path.string().c_str(), &width, &height, &channels, 3);
 
         if(data)
         {
             textureAsset->imageView.data = data;
-            textureAsset->imageView.dataSize = width * height * 3;
+            textureAsset->imageView.dataSize = width * height * 3 * sizeof(float);
             textureAsset->imageView.dataType = LLGL::DataType::Float32;
             textureAsset->imageView.format = LLGL::ImageFormat::RGB;
             
@@ -72,13 +81,17 @@ AssetPtr TextureLoader::Load(const std::filesystem::path& path, AssetPtr existin
 
     auto create = [textureAsset, path]()
     {
-        if(textureAsset->imageView.data)
+        LUSTRA_PROFILE_ZONE("TextureLoader::Upload");
+
+        if(textureAsset->imageView.data && !textureAsset->loadToken.IsCancelled())
         {
             textureAsset->texture = Renderer::Get().CreateTexture(textureAsset->textureDesc, &textureAsset->imageView);
 
+            // The Null backend has no native handles
             LLGL::OpenGL::ResourceNativeHandle nativeHandle;
-            textureAsset->texture->GetNativeHandle(&nativeHandle, sizeof(nativeHandle));
-            textureAsset->nativeHandle = nativeHandle.id;
+
+            if(textureAsset->texture->GetNativeHandle(&nativeHandle, sizeof(nativeHandle)))
+                textureAsset->nativeHandle = nativeHandle.id;
           
             LLGL::Log::Printf(
                 LLGL::Log::ColorFlags::Bold | LLGL::Log::ColorFlags::Green,
@@ -87,16 +100,42 @@ AssetPtr TextureLoader::Load(const std::filesystem::path& path, AssetPtr existin
             );
 
             textureAsset->loaded = true;
+            textureAsset->failed = false;
 
             EventManager::Get().Dispatch(std::make_unique<AssetLoadedEvent>(textureAsset));
         }
+        else if(!textureAsset->loadToken.IsCancelled())
+        {
+            textureAsset->failed = true;
+
+            EventManager::Get().Dispatch(std::make_unique<AssetLoadFailedEvent>(textureAsset));
+        }
 
         stbi_image_free((void*)textureAsset->imageView.data);
+
+        textureAsset->imageView.data = nullptr;
     };
 
     if(true) // Add a "separateThread" parameter
     {
-        Multithreading::Get().AddJob({ path.extension() == ".hdr" ? std::function<void()>(loadFloat) : loadUint, create });
+        // Decoding is skipped once the asset is unloaded, the upload job still runs to free the image.
+        // It also runs if decoding threw, the missing data makes it report the failure
+        auto decode = Multithreading::Get().Schedule(
+            path.extension() == ".hdr" ? std::function<void()>(loadFloat) : loadUint,
+            {},
+            Multithreading::JobThread::Worker,
+            priority,
+            textureAsset->loadToken
+        );
+
+        Multithreading::Get().Schedule(
+            create,
+            { decode },
+            Multithreading::JobThread::Main,
+            priority,
+            {},
+            Multithreading::DependencyFailure::Run
+        );
     }
     else
     {
@@ -148,9 +187,11 @@ void TextureLoader::LoadDefaultData()
     defaultTextureAsset = std::make_shared<TextureAsset>(defaultTexture);
     defaultTextureAsset->sampler = anisotropySampler;
 
+    // The Null backend has no native handles
     LLGL::OpenGL::ResourceNativeHandle nativeHandle;
-    defaultTextureAsset->texture->GetNativeHandle(&nativeHandle, sizeof(nativeHandle));
-    defaultTextureAsset->nativeHandle = nativeHandle.id;
+
+    if(defaultTextureAsset->texture->GetNativeHandle(&nativeHandle, sizeof(nativeHandle)))
+        defaultTextureAsset->nativeHandle = nativeHandle.id;
 
     defaultTextureAsset->loaded = true;
 
@@ -161,8 +202,8 @@ void TextureLoader::LoadDefaultData()
     emptyTextureAsset = std::make_shared<TextureAsset>(emptyTexture);
     emptyTextureAsset->sampler = anisotropySampler;
 
-    emptyTextureAsset->texture->GetNativeHandle(&nativeHandle, sizeof(nativeHandle));
-    emptyTextureAsset->nativeHandle = nativeHandle.id;
+    if(emptyTextureAsset->texture->GetNativeHandle(&nativeHandle, sizeof(nativeHandle)))
+        emptyTextureAsset->nativeHandle = nativeHandle.id;
 
     emptyTextureAsset->loaded = true;
 }
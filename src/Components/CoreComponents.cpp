@@ -1,30 +1,127 @@
 #include <CoreComponents.hpp>
 
-#include <glm/gtx/matrix_decompose.hpp>
-
 namespace lustra
 {
 
-void TransformComponent::SetTransform(const glm::mat4& transform)
+void TransformComponent::SetPosition(const glm::vec3& position)
 {
-    glm::vec3 scale;
-    glm::quat rotation;
-    glm::vec3 position;
-    glm::vec3 skew;
-    glm::vec4 perspective;
-    
-    glm::decompose(transform, scale, rotation, position, skew, perspective);
-    
+    if(this->position == position)
+        return;
+
     this->position = position;
-    this->rotation = glm::degrees(glm::eulerAngles(rotation));
+
+    version++;
+}
+
+void TransformComponent::SetRotation(const glm::quat& rotation)
+{
+    if(this->rotation == rotation)
+        return;
+
+    this->rotation = rotation;
+
+    eulerAnglesValid = false;
+
+    version++;
+}
+
+void TransformComponent::SetScale(const glm::vec3& scale)
+{
+    if(this->scale == scale)
+        return;
+
     this->scale = scale;
+
+    version++;
+}
+
+void TransformComponent::SetEulerAngles(const glm::vec3& eulerAngles)
+{
+    if(eulerAnglesValid && this->eulerAngles == eulerAngles)
+        return;
+
+    rotation = glm::quat(glm::radians(eulerAngles));
+
+    // Kept as given so editing doesn't jump between equivalent angles
+    this->eulerAngles = eulerAngles;
+    eulerAnglesValid = true;
+
+    version++;
+}
+
+void TransformComponent::SetTransform(const glm::mat4& transform)
+{
+    glm::vec3 scale(glm::length(transform[0]), glm::length(transform[1]), glm::length(transform[2]));
+
+    // A mirrored basis keeps the handedness in the scale
+    if(glm::determinant(glm::mat3(transform)) < 0.0f)
+        scale.x = -scale.x;
+
+    SetPosition(transform[3]);
+    SetScale(scale);
+
+    // A flattened axis leaves no rotation to recover
+    if(scale.x == 0.0f || scale.y == 0.0f || scale.z == 0.0f)
+        return;
+
+    glm::mat3 basis(
+        glm::vec3(transform[0]) / scale.x,
+        glm::vec3(transform[1]) / scale.y,
+        glm::vec3(transform[2]) / scale.z
+    );
+
+    SetRotation(glm::normalize(glm::quat_cast(basis)));
+}
+
+const glm::vec3& TransformComponent::GetPosition() const
+{
+    return position;
+}
+
+const glm::quat& TransformComponent::GetRotation() const
+{
+    return rotation;
+}
+
+const glm::vec3& TransformComponent::GetScale() const
+{
+    return scale;
+}
+
+glm::vec3 TransformComponent::GetEulerAngles() const
+{
+    if(!eulerAnglesValid)
+    {
+        eulerAngles = glm::degrees(glm::eulerAngles(rotation));
+        eulerAnglesValid = true;
+    }
+
+    return eulerAngles;
+}
+
+const glm::mat4& TransformComponent::GetTransform() const
+{
+    if(matrixVersion != version)
+    {
+        // Same as translate * toMat4 * scale, without the full matrix products
+        glm::mat3 basis = glm::mat3_cast(rotation);
+
+        matrix = glm::mat4(
+            glm::vec4(basis[0] * scale.x, 0.0f),
+            glm::vec4(basis[1] * scale.y, 0.0f),
+            glm::vec4(basis[2] * scale.z, 0.0f),
+            glm::vec4(position, 1.0f)
+        );
+
+        matrixVersion = version;
+    }
+
+    return matrix;
 }
 
-glm::mat4 TransformComponent::GetTransform() const
+uint32_t TransformComponent::GetVersion() const
 {
-    return glm::translate(glm::mat4(1.0f), position)
-            * glm::toMat4(glm::quat(glm::radians(rotation)))
-            * glm::scale(glm::mat4(1.0f), scale);
+    return version;
 }
 
 LightComponent::LightComponent()
@@ -7,25 +7,40 @@ Application::Application(const Config& config) : config(config)
 {
     LLGL::Log::RegisterCallbackStd(LLGL::Log::StdOutFlags::Colored);
 
+    // Also creates the profiler before any worker thread can record a zone
+    Profiler::Get().SetThreadName("Main");
+
     ScopedTimer timer("App initialization");
 
-    window = std::make_shared<Window>(config.resolution, config.title, 1, config.fullscreen);
+    if(config.headless)
+    {
+        Renderer::Get().Init("Null");
 
-    Renderer::Get().Init();
+        if(!Renderer::Get().IsInit())
+            return;
 
-    if(!Renderer::Get().IsInit())
-        return;
+        Renderer::Get().InitSwapChain(std::make_shared<HeadlessSurface>(config.resolution));
+    }
+    else
+    {
+        window = std::make_shared<Window>(config.resolution, config.title, 1, config.fullscreen);
 
-    Renderer::Get().InitSwapChain(window);
+        Renderer::Get().Init();
 
-    if(config.vsync)
-        Renderer::Get().GetSwapChain()->SetVsyncInterval(1);
+        if(!Renderer::Get().IsInit())
+            return;
 
-    ImGuiManager::Get().Init(
-        window->GetGLFWWindow(),
-        config.imGuiFontPath,
-        config.imGuiLayoutPath
-    );
+        Renderer::Get().InitSwapChain(window);
+
+        if(config.vsync)
+            Renderer::Get().GetSwapChain()->SetVsyncInterval(1);
+
+        ImGuiManager::Get().Init(
+            window->GetGLFWWindow(),
+            config.imGuiFontPath,
+            config.imGuiLayoutPath
+        );
+    }
 
     lustra::PhysicsManager::Get();
 }
@@ -34,7 +49,8 @@ Application::~Application()
 {
     if(Renderer::Get().IsInit())
     {
-        ImGuiManager::Get().Destroy();
+        if(!config.headless)
+            ImGuiManager::Get().Destroy();
         
         Renderer::Get().Unload();
     }
@@ -50,20 +66,52 @@ void Application::Run()
         return;
     }
 
-    while(window->PollEvents())
+    while(PollEvents())
     {
-        LLGL::Surface::ProcessEvents();
+        if(!config.headless)
+            LLGL::Surface::ProcessEvents();
         
         Multithreading::Get().Update();
 
-        Update(deltaTimeTimer.GetElapsedSeconds());
+        EventManager::Get().Flush();
+        EventBus::Get().Flush();
+
+        {
+            LUSTRA_PROFILE_ZONE("Application::Update");
+
+            Update(deltaTimeTimer.GetElapsedSeconds());
+        }
 
         deltaTimeTimer.Reset();
 
-        Render();
+        {
+            LUSTRA_PROFILE_ZONE("Application::Render");
+
+            Render();
+        }
+
+        FrameArena::Get().Reset();
+
+        LUSTRA_PROFILE_FRAME();
     }
 }
 
+void Application::Quit()
+{
+    quit = true;
+}
+
+bool Application::PollEvents()
+{
+    if(quit)
+        return false;
+
+    if(config.headless)
+        return config.headlessFramesNum == 0 || framesNum++ < config.headlessFramesNum;
+
+    return window->PollEvents();
+}
+
 void Application::SetupAssetManager()
 {
     AssetManager::Get().SetAssetsDirectory(config.assetsRoot);
@@ -0,0 +1,108 @@
+#include <Bounds.hpp>
+
+#include <algorithm>
+
+namespace lustra
+{
+
+AABB AABB::Transformed(const glm::mat4& transform) const
+{
+    if(IsEmpty())
+        return {};
+
+    // Arvo: every axis of the matrix contributes its smaller and larger product
+    glm::vec3 newMin(transform[3]), newMax(transform[3]);
+
+    for(int axis = 0; axis < 3; axis++)
+    {
+        glm::vec3 a = glm::vec3(transform[axis]) * min[axis];
+        glm::vec3 b = glm::vec3(transform[axis]) * max[axis];
+
+        newMin += glm::min(a, b);
+        newMax += glm::max(a, b);
+    }
+
+    return { newMin, newMax };
+}
+
+bool Ray::Intersects(const AABB& box, float maxDistance, float& distance) const
+{
+    float entryDistance = 0.0f, exitDistance = maxDistance;
+
+    for(int axis = 0; axis < 3; axis++)
+    {
+        // Infinity for an axis-parallel ray, the comparisons below still work with it
+        float inverse = 1.0f / direction[axis];
+
+        float t0 = (box.min[axis] - origin[axis]) * inverse;
+        float t1 = (box.max[axis] - origin[axis]) * inverse;
+
+        if(inverse < 0.0f)
+            std::swap(t0, t1);
+
+        // Written so a NaN from a ray on the slab's border is ignored
+        entryDistance = t0 > entryDistance ? t0 : entryDistance;
+        exitDistance = t1 < exitDistance ? t1 : exitDistance;
+
+        if(entryDistance > exitDistance)
+            return false;
+    }
+
+    distance = entryDistance;
+
+    return true;
+}
+
+Frustum::Frustum(const glm::mat4& viewProjection)
+{
+    // Gribb and Hartmann, rows of the matrix added to or subtracted from the last one
+    auto row = [&](int index)
+    {
+        return glm::vec4(viewProjection[0][index], viewProjection[1][index], viewProjection[2][index], viewProjection[3][index]);
+    };
+
+    planes[0] = row(3) + row(0); // Left
+    planes[1] = row(3) - row(0); // Right
+    planes[2] = row(3) + row(1); // Bottom
+    planes[3] = row(3) - row(1); // Top
+    planes[4] = row(3) + row(2); // Near
+    planes[5] = row(3) - row(2); // Far
+
+    for(auto& plane : planes)
+        plane /= glm::length(glm::vec3(plane));
+}
+
+Frustum::Result Frustum::Classify(const AABB& box) const
+{
+    auto center = box.GetCenter();
+    auto extent = box.GetExtent();
+
+    auto result = Result::Inside;
+
+    for(auto& plane : planes)
+    {
+        glm::vec3 normal(plane);
+
+        float distance = glm::dot(normal, center) + plane.w;
+        float radius = glm::dot(extent, glm::abs(normal));
+
+        if(distance < -radius)
+            return Result::Outside;
+
+        if(distance < radius)
+            result = Result::Intersects;
+    }
+
+    return result;
+}
+
+bool Frustum::Intersects(const Sphere& sphere) const
+{
+    for(auto& plane : planes)
+        if(glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+            return false;
+
+    return true;
+}
+
+}
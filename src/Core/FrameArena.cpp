@@ -0,0 +1,143 @@
+#include <FrameArena.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace lustra
+{
+
+LinearArena::LinearArena(size_t blockSize)
+    : blockSize(blockSize)
+{
+}
+
+LinearArena::~LinearArena()
+{
+    FreeBlocks();
+}
+
+void LinearArena::Reset()
+{
+    // Everything that was needed this time goes into a single block for the next one
+    if(blocks.size() > 1)
+    {
+        auto capacity = GetCapacity();
+
+        FreeBlocks();
+        AddBlock(capacity);
+    }
+
+    currentBlock = 0;
+    offset = 0;
+    usedBytes = 0;
+}
+
+size_t LinearArena::GetUsedBytes() const
+{
+    return usedBytes;
+}
+
+size_t LinearArena::GetCapacity() const
+{
+    size_t capacity = 0;
+
+    for(auto& block : blocks)
+        capacity += block.size;
+
+    return capacity;
+}
+
+size_t LinearArena::GetBlockAllocationsNum() const
+{
+    return blockAllocationsNum;
+}
+
+void* LinearArena::do_allocate(size_t bytes, size_t alignment)
+{
+    while(currentBlock < blocks.size())
+    {
+        auto& block = blocks[currentBlock];
+
+        auto address = reinterpret_cast<uintptr_t>(block.data) + offset;
+        auto aligned = offset + (((address + alignment - 1) & ~(alignment - 1)) - address);
+
+        if(aligned + bytes <= block.size)
+        {
+            offset = aligned + bytes;
+            usedBytes += bytes;
+
+            return block.data + aligned;
+        }
+
+        currentBlock++;
+        offset = 0;
+    }
+
+    AddBlock(std::max(blockSize, bytes + alignment));
+
+    return do_allocate(bytes, alignment);
+}
+
+void LinearArena::AddBlock(size_t size)
+{
+    blocks.push_back({ static_cast<std::byte*>(::operator new(size, std::align_val_t(alignof(std::max_align_t)))), size });
+
+    blockAllocationsNum++;
+}
+
+void LinearArena::FreeBlocks()
+{
+    for(auto& block : blocks)
+        ::operator delete(block.data, std::align_val_t(alignof(std::max_align_t)));
+
+    blocks.clear();
+}
+
+std::pmr::memory_resource* FrameArena::GetResource()
+{
+    thread_local LinearArena* arena = nullptr;
+
+    if(!arena)
+    {
+        std::lock_guard lock(mutex);
+
+        arena = arenas.emplace_back(std::make_unique<LinearArena>()).get();
+    }
+
+    return arena;
+}
+
+void FrameArena::Reset()
+{
+    std::lock_guard lock(mutex);
+
+    for(auto& arena : arenas)
+        arena->Reset();
+}
+
+size_t FrameArena::GetUsedBytes()
+{
+    std::lock_guard lock(mutex);
+
+    size_t usedBytes = 0;
+
+    for(auto& arena : arenas)
+        usedBytes += arena->GetUsedBytes();
+
+    return usedBytes;
+}
+
+size_t FrameArena::GetBlockAllocationsNum()
+{
+    std::lock_guard lock(mutex);
+
+    size_t blockAllocationsNum = 0;
+
+    for(auto& arena : arenas)
+        blockAllocationsNum += arena->GetBlockAllocationsNum();
+
+    return blockAllocationsNum;
+}
+
+}
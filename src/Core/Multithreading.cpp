@@ -1,38 +1,258 @@
 #include <Multithreading.hpp>
+#include <Timer.hpp>
+#include <Profiler.hpp>
+
+#include <LLGL/Log.h>
+
+#include <algorithm>
+#include <exception>
 
 namespace lustra
 {
 
 void Multithreading::Update()
 {
-    for(size_t i = 0; i < jobs.size(); i++)
+    LUSTRA_PROFILE_ZONE("Multithreading::Update");
+
+    Timer timer;
+
+    mainThreadId = std::this_thread::get_id();
+
+    // Continuations queued by the jobs below wait for the next frame
+    auto readyJobsNum = mainThreadJobsNum.load();
+
+    float budget = frameBudget.count() / 1000.0f;
+
+    JobNodePtr job;
+
+    for(size_t i = 0; i < readyJobsNum && PopMainThreadJob(job); i++)
     {
-        if(!jobs[i].first.valid())
+        mainThreadJobsNum--;
+
+        Run(job);
+
+        if(budget > 0.0f && timer.GetElapsedMilliseconds() >= budget)
+            break;
+    }
+}
+
+void Multithreading::AddJob(const Job& job)
+{
+    JobNodePtr work;
+
+    if(job.first)
+        work = Schedule(job.first);
+
+    if(job.second)
+        Schedule(job.second, work ? std::vector{ work } : std::vector<JobNodePtr>{}, JobThread::Main);
+}
+
+Multithreading::JobNodePtr Multithreading::Schedule(
+    std::function<void()> work,
+    const std::vector<JobNodePtr>& dependencies,
+    JobThread thread,
+    JobPriority priority,
+    const CancellationToken& token,
+    DependencyFailure onDependencyFailure
+)
+{
+    auto node = std::make_shared<JobNode>();
+
+    node->work = std::move(work);
+    node->thread = thread;
+    node->priority = priority;
+    node->token = token;
+    node->onDependencyFailure = onDependencyFailure;
+
+    // The extra count keeps the node from being dispatched before every dependency is registered
+    node->remainingDependencies = dependencies.size() + 1;
+
+    jobsNum++;
+
+    for(auto& dependency : dependencies)
+    {
+        std::lock_guard lock(dependency->mutex);
+
+        if(dependency->finished)
         {
-            if(jobs[i].second)
-                jobs[i].second();
+            if(dependency->failed)
+                node->dependencyFailed = true;
 
-            jobs.erase(jobs.begin() + i);
+            node->remainingDependencies--;
         }
-        else if(jobs[i].first.wait_for(0ms) == std::future_status::ready)
+        else
+            dependency->successors.push_back(node);
+    }
+
+    if(--node->remainingDependencies == 0)
+        Dispatch(node);
+
+    return node;
+}
+
+void Multithreading::ParallelFor(
+    size_t count,
+    const std::function<void(size_t begin, size_t end)>& function,
+    size_t grainSize
+)
+{
+    grainSize = std::max<size_t>(grainSize, 1);
+
+    size_t chunksNum = (count + grainSize - 1) / grainSize;
+
+    if(chunksNum <= 1 || threadPool.GetWorkersNum() == 0)
+    {
+        if(count > 0)
+            function(0, count);
+
+        return;
+    }
+
+    // Shared with the helpers since they may start after this call returned
+    struct State
+    {
+        std::atomic<size_t> nextChunk = 0;
+        std::atomic<size_t> finishedChunks = 0;
+
+        // The first chunk that threw, rethrown on the calling thread
+        std::mutex exceptionMutex;
+        std::exception_ptr exception;
+    };
+
+    auto state = std::make_shared<State>();
+
+    auto runChunks = [state, chunksNum, count, grainSize, &function]()
+    {
+        size_t chunk;
+
+        while((chunk = state->nextChunk++) < chunksNum)
         {
-            jobs[i].second();
+            auto begin = chunk * grainSize;
+
+            // A failed chunk still counts as finished, or the caller would wait forever
+            try
+            {
+                function(begin, std::min(begin + grainSize, count));
+            }
+            catch(...)
+            {
+                std::lock_guard lock(state->exceptionMutex);
 
-            jobs.erase(jobs.begin() + i);
+                if(!state->exception)
+                    state->exception = std::current_exception();
+            }
+
+            state->finishedChunks++;
         }
-    }
+    };
+
+    auto helpersNum = std::min(threadPool.GetWorkersNum(), chunksNum - 1);
+
+    for(size_t i = 0; i < helpersNum; i++)
+        threadPool.Submit(runChunks, ThreadPool::Priority::High);
+
+    runChunks();
+
+    while(state->finishedChunks < chunksNum)
+        std::this_thread::yield();
+
+    if(state->exception)
+        std::rethrow_exception(state->exception);
 }
 
-void Multithreading::AddJob(const Job& job)
+void Multithreading::SetFrameBudget(std::chrono::microseconds budget)
 {
-    auto task = job.first ? std::async(std::launch::async, job.first) : std::future<void>();
-    
-    jobs.emplace_back(std::make_pair(std::move(task), job.second));
+    frameBudget = budget;
+}
+
+std::chrono::microseconds Multithreading::GetFrameBudget() const
+{
+    return frameBudget;
 }
 
 size_t Multithreading::GetJobsNum() const
 {
-    return jobs.size();
+    return jobsNum;
+}
+
+bool Multithreading::IsMainThread() const
+{
+    return mainThreadId.load() == std::this_thread::get_id();
+}
+
+void Multithreading::Dispatch(JobNodePtr node)
+{
+    auto priority = size_t(node->priority);
+
+    if(node->thread == JobThread::Main)
+    {
+        mainThreadJobsNum++;
+        mainThreadJobs[priority].Push(std::move(node));
+    }
+    else
+        threadPool.Submit([this, node]() { Run(node); }, ThreadPool::Priority(priority));
+}
+
+void Multithreading::Run(const JobNodePtr& node)
+{
+    LUSTRA_PROFILE_ZONE("Multithreading::Run");
+
+    // Its inputs may be missing, like a mesh a throwing job never produced
+    if(node->dependencyFailed && node->onDependencyFailure == DependencyFailure::Skip)
+        node->failed = true;
+
+    try
+    {
+        if(node->work && !node->failed && !node->token.IsCancelled())
+            node->work();
+    }
+    catch(const std::exception& exception)
+    {
+        node->failed = true;
+
+        LLGL::Log::Errorf(
+            LLGL::Log::ColorFlags::StdError,
+            "Job failed: %s\n", exception.what()
+        );
+    }
+    catch(...)
+    {
+        node->failed = true;
+
+        LLGL::Log::Errorf(LLGL::Log::ColorFlags::StdError, "Job failed\n");
+    }
+
+    std::vector<JobNodePtr> successors;
+
+    {
+        std::lock_guard lock(node->mutex);
+
+        node->finished = true;
+        successors.swap(node->successors);
+    }
+
+    // Let the captured resources go as soon as the job is done
+    node->work = nullptr;
+
+    jobsNum--;
+
+    for(auto& successor : successors)
+    {
+        if(node->failed)
+            successor->dependencyFailed = true;
+
+        if(--successor->remainingDependencies == 0)
+            Dispatch(successor);
+    }
+}
+
+bool Multithreading::PopMainThreadJob(JobNodePtr& node)
+{
+    for(auto& queue : mainThreadJobs)
+        if(queue.Pop(node))
+            return true;
+
+    return false;
 }
 
 }
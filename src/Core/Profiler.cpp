@@ -0,0 +1,235 @@
+#include <Profiler.hpp>
+
+#include <fstream>
+#include <iomanip>
+
+namespace lustra
+{
+
+namespace
+{
+
+void WriteEscaped(std::ofstream& file, std::string_view string)
+{
+    for(auto character : string)
+    {
+        if(character == '"' || character == '\\')
+            file << '\\';
+
+        file << character;
+    }
+}
+
+}
+
+Profiler::Profiler()
+    : start(std::chrono::steady_clock::now())
+{
+}
+
+void Profiler::SetEnabled(bool enabled)
+{
+    this->enabled = enabled;
+}
+
+bool Profiler::IsEnabled() const
+{
+    return enabled;
+}
+
+void Profiler::SetThreadName(const std::string& name)
+{
+    auto& buffer = GetThreadBuffer();
+
+    std::lock_guard lock(mutex);
+
+    buffer.name = name;
+}
+
+void Profiler::MarkFrame()
+{
+    auto timestamp = GetTimestamp();
+
+    std::lock_guard lock(mutex);
+
+    Collect();
+
+    if(capturing)
+        capturedFrames.push_back(timestamp);
+}
+
+void Profiler::StartCapture()
+{
+    std::lock_guard lock(mutex);
+
+    // Whatever was recorded before the capture started is thrown away
+    capturing = false;
+
+    Collect();
+
+    capturedZones.clear();
+    capturedFrames.clear();
+
+    capturing = true;
+}
+
+bool Profiler::StopCapture(const std::filesystem::path& path)
+{
+    std::lock_guard lock(mutex);
+
+    Collect();
+
+    capturing = false;
+
+    std::ofstream file(path);
+
+    if(!file)
+        return false;
+
+    file << std::fixed << std::setprecision(3);
+
+    file << "{\"traceEvents\":[\n";
+
+    bool first = true;
+
+    auto separate = [&]()
+    {
+        if(!first)
+            file << ",\n";
+
+        first = false;
+    };
+
+    for(auto& buffer : threadBuffers)
+    {
+        separate();
+
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->index << ",\"args\":{\"name\":\"";
+        WriteEscaped(file, buffer->name);
+        file << "\"}}";
+    }
+
+    // Chrome trace timestamps are in microseconds
+    for(auto& zone : capturedZones)
+    {
+        separate();
+
+        file << "{\"name\":\"";
+        WriteEscaped(file, zone.event.name);
+        file << "\",\"ph\":\"X\",\"ts\":" << zone.event.begin / 1000.0
+             << ",\"dur\":" << (zone.event.end - zone.event.begin) / 1000.0
+             << ",\"pid\":0,\"tid\":" << zone.threadIndex << "}";
+    }
+
+    for(auto frame : capturedFrames)
+    {
+        separate();
+
+        file << "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":" << frame / 1000.0 << ",\"pid\":0,\"tid\":0}";
+    }
+
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    capturedZones.clear();
+    capturedFrames.clear();
+
+    return file.good();
+}
+
+bool Profiler::IsCapturing() const
+{
+    return capturing;
+}
+
+uint64_t Profiler::GetDroppedZonesNum() const
+{
+    return droppedZonesNum;
+}
+
+uint64_t Profiler::GetTimestamp() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Profiler::BeginZone()
+{
+    GetThreadBuffer().depth++;
+}
+
+void Profiler::EndZone(const char* name, uint64_t begin)
+{
+    auto end = GetTimestamp();
+
+    auto& buffer = GetThreadBuffer();
+
+    buffer.depth--;
+
+    auto head = buffer.head.load(std::memory_order_relaxed);
+
+    if(head - buffer.tail.load(std::memory_order_acquire) >= ringBufferSize)
+    {
+        droppedZonesNum++;
+        return;
+    }
+
+    buffer.events[head % ringBufferSize] = { name, begin, end, buffer.depth };
+
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+
+    if(!buffer)
+    {
+        std::lock_guard lock(mutex);
+
+        auto& newBuffer = threadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+
+        newBuffer->index = threadBuffers.size() - 1;
+        newBuffer->name = "Thread " + std::to_string(newBuffer->index);
+
+        buffer = newBuffer.get();
+    }
+
+    return *buffer;
+}
+
+void Profiler::Collect()
+{
+    for(auto& buffer : threadBuffers)
+    {
+        auto tail = buffer->tail.load(std::memory_order_relaxed);
+        auto head = buffer->head.load(std::memory_order_acquire);
+
+        if(capturing)
+            for(auto i = tail; i < head; i++)
+                capturedZones.push_back({ buffer->events[i % ringBufferSize], buffer->index });
+
+        buffer->tail.store(head, std::memory_order_release);
+    }
+}
+
+ProfilerZone::ProfilerZone(const char* name)
+    : name(name)
+{
+    auto& profiler = Profiler::Get();
+
+    if(profiler.IsEnabled())
+    {
+        active = true;
+
+        profiler.BeginZone();
+
+        begin = profiler.GetTimestamp();
+    }
+}
+
+ProfilerZone::~ProfilerZone()
+{
+    if(active)
+        Profiler::Get().EndZone(name, begin);
+}
+
+}
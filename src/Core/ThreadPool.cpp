@@ -0,0 +1,168 @@
+#include <ThreadPool.hpp>
+#include <Profiler.hpp>
+
+#include <LLGL/Log.h>
+
+#include <algorithm>
+
+namespace lustra
+{
+
+// Lets Submit() push to the calling worker's own deque
+static thread_local ThreadPool* currentPool = nullptr;
+static thread_local size_t currentWorker = 0;
+
+ThreadPool::ThreadPool(size_t workersNum)
+{
+    workersNum = std::max<size_t>(workersNum, 1);
+
+    workers.reserve(workersNum);
+
+    for(size_t i = 0; i < workersNum; i++)
+        workers.push_back(std::make_unique<Worker>());
+
+    for(size_t i = 0; i < workersNum; i++)
+        workers[i]->thread = std::thread(&ThreadPool::WorkerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(sleepMutex);
+        running = false;
+    }
+
+    sleepCondition.notify_all();
+
+    for(auto& worker : workers)
+        if(worker->thread.joinable())
+            worker->thread.join();
+}
+
+void ThreadPool::Submit(Task task, Priority priority)
+{
+    auto index = currentPool == this
+        ? currentWorker
+        : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+    {
+        std::lock_guard lock(sleepMutex);
+        pendingTasks++;
+    }
+
+    {
+        std::lock_guard lock(workers[index]->mutex);
+        workers[index]->tasks[size_t(priority)].push_back(std::move(task));
+    }
+
+    sleepCondition.notify_one();
+}
+
+size_t ThreadPool::GetWorkersNum() const
+{
+    return workers.size();
+}
+
+size_t ThreadPool::GetDefaultWorkersNum()
+{
+    // Leave one core for the main thread
+    auto hardwareThreads = std::thread::hardware_concurrency();
+
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+}
+
+void ThreadPool::WorkerLoop(size_t index)
+{
+    Profiler::Get().SetThreadName("Worker " + std::to_string(index));
+
+    currentPool = this;
+    currentWorker = index;
+
+    Task task;
+
+    while(true)
+    {
+        if(Pop(index, task))
+        {
+            // ParallelFor and Multithreading::Run hand their errors to the caller,
+            // this only keeps a raw task from taking the process down
+            try
+            {
+                task();
+            }
+            catch(const std::exception& exception)
+            {
+                LLGL::Log::Errorf(
+                    LLGL::Log::ColorFlags::StdError,
+                    "Task failed: %s\n", exception.what()
+                );
+            }
+            catch(...)
+            {
+                LLGL::Log::Errorf(LLGL::Log::ColorFlags::StdError, "Task failed\n");
+            }
+
+            task = nullptr;
+
+            continue;
+        }
+
+        std::unique_lock lock(sleepMutex);
+
+        sleepCondition.wait(lock, [&]() { return !running || pendingTasks > 0; });
+
+        if(!running)
+            break;
+    }
+}
+
+bool ThreadPool::Pop(size_t index, Task& task)
+{
+    for(size_t priority = 0; priority < prioritiesNum; priority++)
+        if(PopLocal(index, priority, task) || Steal(index, priority, task))
+            return true;
+
+    return false;
+}
+
+bool ThreadPool::PopLocal(size_t index, size_t priority, Task& task)
+{
+    auto& tasks = workers[index]->tasks[priority];
+
+    std::lock_guard lock(workers[index]->mutex);
+
+    if(tasks.empty())
+        return false;
+
+    task = std::move(tasks.back());
+    tasks.pop_back();
+
+    pendingTasks--;
+
+    return true;
+}
+
+bool ThreadPool::Steal(size_t index, size_t priority, Task& task)
+{
+    for(size_t i = 1; i < workers.size(); i++)
+    {
+        auto& victim = *workers[(index + i) % workers.size()];
+        auto& tasks = victim.tasks[priority];
+
+        std::lock_guard lock(victim.mutex);
+
+        if(tasks.empty())
+            continue;
+
+        task = std::move(tasks.front());
+        tasks.pop_front();
+
+        pendingTasks--;
+
+        return true;
+    }
+
+    return false;
+}
+
+}
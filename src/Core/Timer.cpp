@@ -30,13 +30,17 @@ float Timer::GetElapsedMilliseconds()
     return float(duration.count()) / 1000.0f;
 }
 
-ScopedTimer::ScopedTimer(std::string_view name) : name(name) {}
+#ifdef LUSTRA_PROFILER
+ScopedTimer::ScopedTimer(const char* name) : name(name), zone(name) {}
+#else
+ScopedTimer::ScopedTimer(const char* name) : name(name) {}
+#endif
 
 ScopedTimer::~ScopedTimer()
 {
     LLGL::Log::Printf(
         LLGL::Log::ColorFlags::Bold | LLGL::Log::ColorFlags::Blue, 
-        "%s took %.3f ms\n", name.data(), timer.GetElapsedMilliseconds()
+        "%s took %.3f ms\n", name, timer.GetElapsedMilliseconds()
     );
 }
 
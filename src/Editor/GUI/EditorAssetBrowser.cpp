@@ -214,20 +214,23 @@ void Editor::DrawUnloadedAsset(const std::filesystem::path& entry)
 
     ImGui::ImageButton("##Asset", assetIcons[assetType]->nativeHandle, ImVec2(128.0f, 128.0f));
 
+    // Only brought into the cache, nothing in the scene uses it yet
+    auto priority = lustra::Multithreading::JobPriority::Prefetch;
+
     if(ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(0))
     {
         switch(assetType)
         {
             case lustra::Asset::Type::Texture:
-                lustra::AssetManager::Get().Load<lustra::TextureAsset>(entry);
+                lustra::AssetManager::Get().Load<lustra::TextureAsset>(entry, false, true, priority);
                 break;
 
             case lustra::Asset::Type::Material:
-                lustra::AssetManager::Get().Load<lustra::MaterialAsset>(entry);
+                lustra::AssetManager::Get().Load<lustra::MaterialAsset>(entry, false, true, priority);
                 break;
 
             case lustra::Asset::Type::Model:
-                lustra::AssetManager::Get().Load<lustra::ModelAsset>(entry);
+                lustra::AssetManager::Get().Load<lustra::ModelAsset>(entry, false, true, priority);
                 break;
 
             case lustra::Asset::Type::Script:
@@ -14,6 +14,7 @@ void Editor::DrawImGui()
     DrawPropertiesWindow();
     DrawImGuizmoControls();
     DrawExecutionControl();
+    DrawMemoryUsage();
     DrawAssetBrowser();
 
     if(selectedAsset)
@@ -81,7 +82,7 @@ void Editor::DrawSceneTree()
         {
             auto entity = scene->CreateEntity();
 
-            entity.AddComponent<lustra::NameComponent>().name = "Empty";
+            entity.AddComponent<lustra::NameComponent>("Empty");
 
             selectedEntity = entity;
 
@@ -92,7 +93,7 @@ void Editor::DrawSceneTree()
         {
             auto entity = scene->CreateEntity();
 
-            entity.AddComponent<lustra::NameComponent>().name = "Drawable";
+            entity.AddComponent<lustra::NameComponent>("Drawable");
             entity.AddComponent<lustra::TransformComponent>();
             entity.AddComponent<lustra::MeshComponent>();
             entity.AddComponent<lustra::MeshRendererComponent>();
@@ -353,8 +354,8 @@ void Editor::DrawImGuizmo()
                 auto body = selectedEntity.GetComponent<lustra::RigidBodyComponent>().body;
                 auto bodyId = body->GetID();
 
-                auto pos = transform.position;
-                auto rot = glm::quat(glm::radians(transform.rotation));
+                auto pos = transform.GetPosition();
+                auto rot = transform.GetRotation();
 
                 lustra::PhysicsManager::Get().GetBodyInterface().SetPositionAndRotation(
                     bodyId,
@@ -455,6 +456,101 @@ void Editor::DrawExecutionControl()
     if(ImGui::ImageButton("##Build", buildIcon->nativeHandle, { 20, 20 }))
         lustra::ScriptManager::Get().Build();
 
+    ImGui::SameLine();
+
+    // Open the result in chrome://tracing or ui.perfetto.dev
+    if(!lustra::Profiler::Get().IsCapturing())
+    {
+        if(ImGui::Button("Capture trace"))
+            lustra::Profiler::Get().StartCapture();
+    }
+    else if(ImGui::Button("Save trace"))
+        lustra::Profiler::Get().StopCapture("trace.json");
+
+    ImGui::SameLine();
+
+    if(ImGui::Button("Save frame stats"))
+        lustra::Renderer::Get().WriteFrameStatsCsv("frame_stats.csv");
+
+    ImGui::End();
+}
+
+void Editor::DrawMemoryUsage()
+{
+    static const std::unordered_map<lustra::Asset::Type, const char*> typeNames =
+    {
+        { lustra::Asset::Type::Unknown, "Unknown" },
+        { lustra::Asset::Type::Texture, "Textures" },
+        { lustra::Asset::Type::Material, "Materials" },
+        { lustra::Asset::Type::Model, "Models" },
+        { lustra::Asset::Type::Environment, "Environments" },
+        { lustra::Asset::Type::Script, "Scripts" },
+        { lustra::Asset::Type::VertexShader, "Vertex shaders" },
+        { lustra::Asset::Type::FragmentShader, "Fragment shaders" },
+        { lustra::Asset::Type::Scene, "Scenes" }
+    };
+
+    auto megabytes = [](uint64_t bytes)
+    {
+        return bytes / (1024.0f * 1024.0f);
+    };
+
+    ImGui::Begin("Memory");
+
+    if(ImGui::BeginTable("##MemoryUsage", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+    {
+        ImGui::TableSetupColumn("");
+        ImGui::TableSetupColumn("CPU, MB");
+        ImGui::TableSetupColumn("GPU, MB");
+        ImGui::TableHeadersRow();
+
+        auto row = [&](const char* name, const lustra::MemoryUsage& usage)
+        {
+            ImGui::TableNextRow();
+
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name);
+
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", megabytes(usage.cpuBytes));
+
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", megabytes(usage.gpuBytes));
+        };
+
+        lustra::MemoryUsage total;
+
+        for(auto& [type, usage] : lustra::AssetManager::Get().GetMemoryUsage())
+        {
+            row(typeNames.at(type), usage);
+
+            total += usage;
+        }
+
+        // Environments are owned by the sky components rather than the asset cache
+        auto environments = scene->GetEnvironmentsMemoryUsage();
+        auto shadowMaps = scene->GetShadowMapsMemoryUsage();
+
+        row("Scene environments", environments);
+        row("Shadow maps", shadowMaps);
+
+        total += environments;
+        total += shadowMaps;
+
+        row("Total", total);
+
+        ImGui::EndTable();
+    }
+
+    // Everything the renderer allocated, render targets and uniform buffers included
+    auto& gpuMemoryStats = lustra::Renderer::Get().GetGpuMemoryStats();
+
+    ImGui::Text(
+        "Renderer: %.2f MB in %llu textures, %.2f MB in %llu buffers",
+        megabytes(gpuMemoryStats.textureBytes), (unsigned long long)gpuMemoryStats.texturesNum,
+        megabytes(gpuMemoryStats.bufferBytes), (unsigned long long)gpuMemoryStats.buffersNum
+    );
+
     ImGui::End();
 }
 
@@ -515,7 +611,7 @@ void Editor::DrawViewport()
         auto[transform, light] = 
             lights.get<lustra::TransformComponent, lustra::LightComponent>(entity);
 
-        auto screenPos = editorCamera.GetComponent<lustra::CameraComponent>().camera.WorldToScreen(transform.position);
+        auto screenPos = editorCamera.GetComponent<lustra::CameraComponent>().camera.WorldToScreen(transform.GetPosition());
 
         if(!glm::any(glm::isnan(screenPos)))
         {
@@ -40,8 +40,8 @@ void Editor::CreateCameraEntity()
 {
     auto camera = scene->CreateEntity();
 
-    camera.AddComponent<lustra::NameComponent>().name = "Camera";
-    camera.AddComponent<lustra::TransformComponent>().position = { 5.0f, 5.0f, 5.0f };
+    camera.AddComponent<lustra::NameComponent>("Camera");
+    camera.AddComponent<lustra::TransformComponent>().SetPosition({ 5.0f, 5.0f, 5.0f });
     
     auto& cameraComponent = camera.AddComponent<lustra::CameraComponent>();
     
@@ -53,8 +53,8 @@ void Editor::CreateEditorCameraEntity()
 {
     editorCamera = scene->CreateEntity();
 
-    editorCamera.AddComponent<lustra::NameComponent>().name = "EditorCamera";
-    editorCamera.AddComponent<lustra::TransformComponent>().position = { 0.0f, 0.0f, 5.0f };
+    editorCamera.AddComponent<lustra::NameComponent>("EditorCamera");
+    editorCamera.AddComponent<lustra::TransformComponent>().SetPosition({ 0.0f, 0.0f, 5.0f });
     
     auto& cameraComponent = editorCamera.AddComponent<lustra::CameraComponent>();
     
@@ -69,7 +69,7 @@ void Editor::CreatePostProcessingEntity()
 {
     auto postProcessing = scene->CreateEntity();
 
-    postProcessing.AddComponent<lustra::NameComponent>().name = "PostProcessing";
+    postProcessing.AddComponent<lustra::NameComponent>("PostProcessing");
     postProcessing.AddComponent<lustra::TonemapComponent>(LLGL::Extent2D{ 1280, 720 });
     postProcessing.AddComponent<lustra::BloomComponent>(LLGL::Extent2D{ 1280, 720 });
     postProcessing.AddComponent<lustra::GTAOComponent>(LLGL::Extent2D{ 1280, 720 });
@@ -80,7 +80,7 @@ void Editor::CreateSkyEntity()
 {
     auto sky = scene->CreateEntity();
     
-    sky.AddComponent<lustra::NameComponent>().name = "Sky";
+    sky.AddComponent<lustra::NameComponent>("Sky");
     sky.AddComponent<lustra::MeshComponent>().model = lustra::AssetManager::Get().Load<lustra::ModelAsset>("cube", true);
 
     sky.AddComponent<lustra::ProceduralSkyComponent>(LLGL::Extent2D{ 1024, 1024 });
@@ -123,7 +123,7 @@ void Editor::UpdateEditorCameraScript()
         {
             lustra::Mouse::SetCursorVisible(false);
 
-            auto rotation = glm::quat(glm::radians(transform.rotation));
+            auto rotation = transform.GetRotation();
 
             glm::vec3 input = glm::vec3(0.0f);
 
@@ -147,15 +147,19 @@ void Editor::UpdateEditorCameraScript()
                 speed = glm::mix(speed, 0.0f, lerpSpeed);
 
             if(speed > 0.0f)
-                transform.position += glm::normalize(movement) * deltaTime * speed;
+                transform.SetPosition(transform.GetPosition() + glm::normalize(movement) * deltaTime * speed);
 
             glm::vec2 center(window->GetContentSize().width / 2.0f, window->GetContentSize().height / 2.0f);
             glm::vec2 delta = center - lustra::Mouse::GetPosition();
 
-            transform.rotation.x += delta.y / 100.0f;
-            transform.rotation.y += delta.x / 100.0f;
+            auto eulerAngles = transform.GetEulerAngles();
 
-            transform.rotation.x = glm::clamp(transform.rotation.x, -89.0f, 89.0f);
+            eulerAngles.x += delta.y / 100.0f;
+            eulerAngles.y += delta.x / 100.0f;
+
+            eulerAngles.x = glm::clamp(eulerAngles.x, -89.0f, 89.0f);
+
+            transform.SetEulerAngles(eulerAngles);
 
             lustra::Mouse::SetPosition(center);
         }
@@ -190,7 +194,7 @@ void Editor::CreateModelEntity(lustra::ModelAssetPtr model, bool relativeToCamer
 {
     auto entity = scene->CreateEntity();
 
-    entity.AddComponent<lustra::NameComponent>().name = "Model";
+    entity.AddComponent<lustra::NameComponent>("Model");
     entity.AddComponent<lustra::TransformComponent>();
     entity.AddComponent<lustra::MeshComponent>().model = model;
     entity.AddComponent<lustra::MeshRendererComponent>();
@@ -201,17 +205,17 @@ void Editor::CreateModelEntity(lustra::ModelAssetPtr model, bool relativeToCamer
     
     auto& rigidBody = entity.AddComponent<lustra::RigidBodyComponent>();
 
-    auto& modelPos = entity.GetComponent<lustra::TransformComponent>().position;
+    auto& modelTransform = entity.GetComponent<lustra::TransformComponent>();
 
     if(relativeToCamera)
     {
-        auto& cameraPos = editorCamera.GetComponent<lustra::TransformComponent>().position;
+        auto& cameraTransform = editorCamera.GetComponent<lustra::TransformComponent>();
 
-        auto cameraOrient = glm::quat(glm::radians(editorCamera.GetComponent<lustra::TransformComponent>().rotation));
-
-        modelPos = cameraPos + cameraOrient * glm::vec3(0.0f, 0.0f, -5.0f);
+        modelTransform.SetPosition(cameraTransform.GetPosition() + cameraTransform.GetRotation() * glm::vec3(0.0f, 0.0f, -5.0f));
     }
 
+    auto& modelPos = modelTransform.GetPosition();
+
     auto settings =
         JPH::BodyCreationSettings(
             new JPH::EmptyShapeSettings(),
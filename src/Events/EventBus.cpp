@@ -0,0 +1,33 @@
+#include <EventBus.hpp>
+
+namespace lustra
+{
+
+void EventBus::Flush()
+{
+    // The lock isn't held while flushing since a listener may use a new event type
+    for(size_t i = 0;; i++)
+    {
+        ChannelBase* channel = nullptr;
+
+        {
+            std::lock_guard lock(channelsMutex);
+
+            if(i >= channels.size())
+                break;
+
+            channel = channels[i];
+        }
+
+        channel->Flush();
+    }
+}
+
+void EventBus::AddChannel(ChannelBase* channel)
+{
+    std::lock_guard lock(channelsMutex);
+
+    channels.push_back(channel);
+}
+
+}
@@ -35,4 +35,39 @@ void EventManager::Dispatch(std::unique_ptr<Event> event)
     }
 }
 
+void EventManager::Post(std::unique_ptr<Event> event, bool coalesce)
+{
+    postedEvents.Push({ std::move(event), coalesce });
+}
+
+void EventManager::Flush()
+{
+    std::vector<PostedEvent> batch;
+
+    PostedEvent posted;
+
+    while(postedEvents.Pop(posted))
+        batch.push_back(std::move(posted));
+
+    // Walk backwards so the last event of every coalesced type survives
+    uint64_t coalescedTypes = 0;
+
+    for(auto it = batch.rbegin(); it != batch.rend(); it++)
+    {
+        if(!it->coalesce)
+            continue;
+
+        auto typeBit = uint64_t(1) << uint64_t(it->event->GetType());
+
+        if(coalescedTypes & typeBit)
+            it->event.reset();
+        else
+            coalescedTypes |= typeBit;
+    }
+
+    for(auto& batched : batch)
+        if(batched.event)
+            Dispatch(std::move(batched.event));
+}
+
 }
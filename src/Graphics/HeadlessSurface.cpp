@@ -0,0 +1,37 @@
+#include <HeadlessSurface.hpp>
+
+namespace lustra
+{
+
+HeadlessSurface::HeadlessSurface(const LLGL::Extent2D& size)
+    : size(size)
+{
+}
+
+bool HeadlessSurface::GetNativeHandle(void* nativeHandle, size_t size)
+{
+    return false;
+}
+
+bool HeadlessSurface::AdaptForVideoMode(LLGL::Extent2D* resolution, bool* fullscreen)
+{
+    if(resolution)
+        size = *resolution;
+
+    if(fullscreen)
+        *fullscreen = false;
+
+    return true;
+}
+
+LLGL::Extent2D HeadlessSurface::GetContentSize() const
+{
+    return size;
+}
+
+LLGL::Display* HeadlessSurface::FindResidentDisplay() const
+{
+    return nullptr;
+}
+
+}
@@ -5,6 +5,15 @@ namespace lustra
 
 Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, bool setupBuffers)
             : vertices(vertices), indices(indices)
+{
+    ComputeBounds();
+
+    if(setupBuffers)
+        SetupBuffers();
+}
+
+Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const AABB& bounds, bool setupBuffers)
+            : vertices(vertices), indices(indices), bounds(bounds)
 {
     if(setupBuffers)
         SetupBuffers();
@@ -64,6 +73,7 @@ void Mesh::CreateCube()
         20, 21, 22, 20, 22, 23
     };
 
+    ComputeBounds();
     SetupBuffers();
 }
 
@@ -79,6 +89,7 @@ void Mesh::CreatePlane()
 
     indices = { 0, 1, 2, 2, 1, 3 };
 
+    ComputeBounds();
     SetupBuffers();
 }
 
@@ -92,12 +103,16 @@ void Mesh::BindBuffers(LLGL::CommandBuffer* commandBuffer, bool bindMatrices) co
         auto matricesBinding = Renderer::Get().GetMatrices()->GetBinding();
         
         commandBuffer->UpdateBuffer(*matricesBuffer, 0, &matricesBinding, sizeof(Matrices::Binding));
+
+        Renderer::Get().CountBufferUpdate(sizeof(Matrices::Binding));
     }
 }
 
 void Mesh::Draw(LLGL::CommandBuffer* commandBuffer) const
 {
     commandBuffer->DrawIndexed(indices.size(), 0);
+
+    Renderer::Get().CountDrawCall();
 }
 
 std::vector<Vertex> Mesh::GetVertices() const
@@ -110,6 +125,20 @@ std::vector<uint32_t> Mesh::GetIndices() const
     return indices;
 }
 
+const AABB& Mesh::GetBounds() const
+{
+    return bounds;
+}
+
+MemoryUsage Mesh::GetMemoryUsage() const
+{
+    return
+    {
+        vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(uint32_t),
+        Renderer::Get().GetResourceSize(vertexBuffer) + Renderer::Get().GetResourceSize(indexBuffer)
+    };
+}
+
 void Mesh::CreateVertexBuffer()
 {
     LLGL::BufferDescriptor bufferDesc = LLGL::VertexBufferDesc(vertices.size() * sizeof(Vertex), vertexFormat);
@@ -124,4 +153,12 @@ void Mesh::CreateIndexBuffer()
     indexBuffer = Renderer::Get().CreateBuffer(bufferDesc, indices.data());
 }
 
+void Mesh::ComputeBounds()
+{
+    bounds = {};
+
+    for(auto& vertex : vertices)
+        bounds.Merge(vertex.position);
+}
+
 }
@@ -1,5 +1,9 @@
 #include <Renderer.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
 namespace lustra
 {
 
@@ -8,7 +12,7 @@ Renderer::Renderer()
     
 }
 
-void Renderer::Init()
+void Renderer::Init(const std::string& module)
 {
     if(renderSystem)
     {
@@ -22,7 +26,7 @@ void Renderer::Init()
 
     try
     {
-        LoadRenderSystem("OpenGL");
+        LoadRenderSystem(module.c_str());
     }
     catch(const std::runtime_error& error)
     {
@@ -93,47 +97,74 @@ void Renderer::End()
 }
 
 void Renderer::RenderPass(
-    std::function<void(LLGL::CommandBuffer*)> setupBuffers,
-    const std::unordered_map<uint32_t, LLGL::Resource*>& resources,
-    std::function<void(LLGL::CommandBuffer*)> draw,
+    CommandFunction setupBuffers,
+    std::initializer_list<ResourceBinding> resources,
+    CommandFunction draw,
     LLGL::PipelineState* pipeline,
     LLGL::RenderTarget* renderTarget
 )
 {
-    setupBuffers(commandBuffer);
-
-    commandBuffer->BeginRenderPass(renderTarget ? *renderTarget : *swapChain);
-    {
-        swapChain->ResizeBuffers(swapChain->GetSurface().GetContentSize());
-        
-        if(pipeline)
+    ExecuteRenderPass(
+        setupBuffers,
+        [&](auto commandBuffer)
         {
-            commandBuffer->SetViewport(renderTarget ? renderTarget->GetResolution() : swapChain->GetResolution());
+            for(auto const& [key, val] : resources)
+                commandBuffer->SetResource(key, *val);
 
-            if(renderPassCounter == 0)
-                commandBuffer->Clear(LLGL::ClearFlags::ColorDepth);
-
-            commandBuffer->SetPipelineState(*pipeline);
-
-            renderPassCounter++;
-        }
+            frameStats.total.resourceBinds += resources.size();
+            frameStats.GetRenderTargetStats(renderTarget).resourceBinds += resources.size();
+        },
+        draw, pipeline, renderTarget
+    );
+}
 
-        for(auto const& [key, val] : resources)
-            commandBuffer->SetResource(key, *val);
+void Renderer::RenderPass(
+    CommandFunction setupBuffers,
+    const std::unordered_map<uint32_t, LLGL::Resource*>& resources,
+    CommandFunction draw,
+    LLGL::PipelineState* pipeline,
+    LLGL::RenderTarget* renderTarget
+)
+{
+    ExecuteRenderPass(
+        setupBuffers,
+        [&](auto commandBuffer)
+        {
+            for(auto const& [key, val] : resources)
+                commandBuffer->SetResource(key, *val);
 
-        draw(commandBuffer);
-    }
-    commandBuffer->EndRenderPass();
+            frameStats.total.resourceBinds += resources.size();
+            frameStats.GetRenderTargetStats(renderTarget).resourceBinds += resources.size();
+        },
+        draw, pipeline, renderTarget
+    );
 }
 
 void Renderer::Submit()
 {
     commandQueue->Submit(*commandBuffer);
+
+    frameStats.total.submits++;
 }
 
 void Renderer::Present()
 {
     swapChain->Present();
+
+    if(frameStatsHistorySize > 0)
+    {
+        if(frameStatsHistory.size() < frameStatsHistorySize)
+            frameStatsHistory.push_back(frameStats);
+        else
+            frameStatsHistory[frameStatsHistoryNext] = frameStats;
+
+        frameStatsHistoryNext = (frameStatsHistoryNext + 1) % frameStatsHistorySize;
+    }
+
+    auto frame = frameStats.frame;
+
+    frameStats.Clear();
+    frameStats.frame = frame + 1;
 }
 
 void Renderer::ClearRenderTarget(LLGL::RenderTarget* renderTarget, bool begin)
@@ -184,12 +215,17 @@ void Renderer::Unload()
 
     defaultVertexFormat = LLGL::VertexFormat();
 
+    gpuMemoryStats = {};
+    trackedResources.clear();
+
     LLGL::RenderSystem::Unload(std::move(renderSystem));
 }
 
 void Renderer::WriteTexture(LLGL::Texture& texture, const LLGL::TextureRegion& textureRegion, const LLGL::ImageView& srcImageView)
 {
     renderSystem->WriteTexture(texture, textureRegion, srcImageView);
+
+    frameStats.total.textureUploads++;
 }
 
 void Renderer::SetViewportResolution(const LLGL::Extent2D& resolution)
@@ -204,7 +240,11 @@ LLGL::Extent2D Renderer::GetViewportResolution() const
 
 LLGL::Buffer* Renderer::CreateBuffer(const LLGL::BufferDescriptor& bufferDesc, const void* initialData)
 {
-    return renderSystem->CreateBuffer(bufferDesc, initialData);
+    auto buffer = renderSystem->CreateBuffer(bufferDesc, initialData);
+
+    TrackResource(buffer, bufferDesc.size, false);
+
+    return buffer;
 }
 
 LLGL::Buffer* Renderer::CreateBuffer(const std::string& name, const LLGL::BufferDescriptor& bufferDesc, const void* initialData)
@@ -216,6 +256,8 @@ LLGL::Buffer* Renderer::CreateBuffer(const std::string& name, const LLGL::Buffer
 
     auto buffer = renderSystem->CreateBuffer(bufferDesc, initialData);
 
+    TrackResource(buffer, bufferDesc.size, false);
+
     globalBuffers[name] = buffer;
 
     return buffer;
@@ -247,7 +289,18 @@ LLGL::Shader* Renderer::CreateShader(const LLGL::ShaderType& type, const std::fi
 
 LLGL::Texture* Renderer::CreateTexture(const LLGL::TextureDescriptor& textureDesc, const LLGL::ImageView* initialImage)
 {
-    return renderSystem->CreateTexture(textureDesc, initialImage);
+    if(initialImage)
+        frameStats.total.textureUploads++;
+
+    auto texture = renderSystem->CreateTexture(textureDesc, initialImage);
+
+    // Multisampled textures keep every sample
+    auto size = LLGL::GetMemoryFootprint(textureDesc.format, LLGL::NumMipTexels(textureDesc))
+        * std::max(textureDesc.samples, 1u);
+
+    TrackResource(texture, size, true);
+
+    return texture;
 }
 
 LLGL::Sampler* Renderer::CreateSampler(const LLGL::SamplerDescriptor& samplerDesc)
@@ -388,6 +441,102 @@ bool Renderer::IsInit()
     return renderSystem != nullptr;// && swapChain != nullptr;
 }
 
+void Renderer::CountDrawCall()
+{
+    frameStats.total.drawCalls++;
+    frameStats.GetRenderTargetStats(currentRenderTarget).drawCalls++;
+}
+
+void Renderer::CountBufferUpdate(uint64_t bytes)
+{
+    frameStats.total.bufferUpdateBytes += bytes;
+    frameStats.GetRenderTargetStats(currentRenderTarget).bufferUpdateBytes += bytes;
+}
+
+void Renderer::CountCulling(const LLGL::RenderTarget* renderTarget, uint64_t visible, uint64_t culled)
+{
+    frameStats.total.meshesVisible += visible;
+    frameStats.total.meshesCulled += culled;
+
+    auto& stats = frameStats.GetRenderTargetStats(renderTarget);
+
+    stats.meshesVisible += visible;
+    stats.meshesCulled += culled;
+}
+
+const FrameStats& Renderer::GetFrameStats() const
+{
+    // The newest entry is right before the next one to be written
+    if(frameStatsHistory.empty())
+        return frameStats;
+
+    return frameStatsHistory[(frameStatsHistoryNext + frameStatsHistory.size() - 1) % frameStatsHistory.size()];
+}
+
+bool Renderer::WriteFrameStatsCsv(const std::filesystem::path& path) const
+{
+    std::ofstream file(path);
+
+    if(!file)
+        return false;
+
+    file << "frame,target,renderPasses,drawCalls,pipelineBinds,resourceBinds,bufferUpdateBytes,textureUploads,submits,meshesVisible,meshesCulled\n";
+
+    auto writeRow = [&](uint64_t frame, const std::string& target, const RenderStats& stats)
+    {
+        file << frame << ',' << target << ','
+             << stats.renderPasses << ',' << stats.drawCalls << ','
+             << stats.pipelineBinds << ',' << stats.resourceBinds << ','
+             << stats.bufferUpdateBytes << ',' << stats.textureUploads << ','
+             << stats.submits << ',' << stats.meshesVisible << ','
+             << stats.meshesCulled << '\n';
+    };
+
+    // Oldest first, the ring only wrapped once it's full
+    auto start = frameStatsHistory.size() < frameStatsHistorySize ? 0 : frameStatsHistoryNext;
+
+    for(size_t i = 0; i < frameStatsHistory.size(); i++)
+    {
+        auto& entry = frameStatsHistory[(start + i) % frameStatsHistory.size()];
+
+        writeRow(entry.frame, "total", entry.total);
+
+        for(auto& [renderTarget, stats] : entry.renderTargets)
+        {
+            std::ostringstream target;
+
+            if(renderTarget)
+                target << renderTarget;
+            else
+                target << "swapchain";
+
+            writeRow(entry.frame, target.str(), stats);
+        }
+    }
+
+    return file.good();
+}
+
+void Renderer::SetFrameStatsHistorySize(size_t size)
+{
+    frameStatsHistorySize = size;
+
+    frameStatsHistory.clear();
+    frameStatsHistoryNext = 0;
+}
+
+uint64_t Renderer::GetResourceSize(const void* resource) const
+{
+    auto it = trackedResources.find(resource);
+
+    return it != trackedResources.end() ? it->second.size : 0;
+}
+
+const GpuMemoryStats& Renderer::GetGpuMemoryStats() const
+{
+    return gpuMemoryStats;
+}
+
 void Renderer::LoadRenderSystem(const LLGL::RenderSystemDescriptor& desc)
 {
     LLGL::Report report;
@@ -417,6 +566,8 @@ void Renderer::CreateMatricesBuffer()
     LLGL::BufferDescriptor bufferDesc = LLGL::ConstantBufferDesc(sizeof(Matrices::Binding));
 
     matricesBuffer = renderSystem->CreateBuffer(bufferDesc);
+
+    TrackResource(matricesBuffer, bufferDesc.size, false);
 }
 
 void Renderer::SetupBuffers()
@@ -426,4 +577,85 @@ void Renderer::SetupBuffers()
     CreateMatricesBuffer();
 }
 
+void Renderer::TrackResource(const void* resource, uint64_t size, bool texture)
+{
+    if(!resource)
+        return;
+
+    trackedResources[resource] = { size, texture };
+
+    if(texture)
+    {
+        gpuMemoryStats.textureBytes += size;
+        gpuMemoryStats.texturesNum++;
+    }
+    else
+    {
+        gpuMemoryStats.bufferBytes += size;
+        gpuMemoryStats.buffersNum++;
+    }
+}
+
+void Renderer::UntrackResource(const void* resource)
+{
+    auto it = trackedResources.find(resource);
+
+    if(it == trackedResources.end())
+        return;
+
+    if(it->second.texture)
+    {
+        gpuMemoryStats.textureBytes -= it->second.size;
+        gpuMemoryStats.texturesNum--;
+    }
+    else
+    {
+        gpuMemoryStats.bufferBytes -= it->second.size;
+        gpuMemoryStats.buffersNum--;
+    }
+
+    trackedResources.erase(it);
+}
+
+void Renderer::ExecuteRenderPass(
+    CommandFunction setupBuffers,
+    CommandFunction setResources,
+    CommandFunction draw,
+    LLGL::PipelineState* pipeline,
+    LLGL::RenderTarget* renderTarget
+)
+{
+    currentRenderTarget = renderTarget;
+
+    setupBuffers(commandBuffer);
+
+    commandBuffer->BeginRenderPass(renderTarget ? *renderTarget : *swapChain);
+
+    frameStats.total.renderPasses++;
+    frameStats.GetRenderTargetStats(renderTarget).renderPasses++;
+    {
+        swapChain->ResizeBuffers(swapChain->GetSurface().GetContentSize());
+        
+        if(pipeline)
+        {
+            commandBuffer->SetViewport(renderTarget ? renderTarget->GetResolution() : swapChain->GetResolution());
+
+            if(renderPassCounter == 0)
+                commandBuffer->Clear(LLGL::ClearFlags::ColorDepth);
+
+            commandBuffer->SetPipelineState(*pipeline);
+
+            frameStats.total.pipelineBinds++;
+            frameStats.GetRenderTargetStats(renderTarget).pipelineBinds++;
+
+            renderPassCounter++;
+        }
+
+        setResources(commandBuffer);
+
+        draw(commandBuffer);
+    }
+    commandBuffer->EndRenderPass();
+}
+
 }
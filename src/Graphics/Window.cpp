@@ -10,7 +10,8 @@ static void OnWindowResize(GLFWwindow* window, int width, int height)
 {
     auto event = std::make_unique<WindowResizeEvent>(LLGL::Extent2D{ (uint32_t)width, (uint32_t)height });
 
-    EventManager::Get().Dispatch(std::move(event));
+    // A drag fires a resize per mouse move, only the last size matters
+    EventManager::Get().Post(std::move(event), true);
 }
 
 static void OnWindowFocus(GLFWwindow* window, int focused)
@@ -8,17 +8,26 @@ namespace Keyboard
 
 bool IsKeyPressed(Key key)
 {
-    return glfwGetKey(Window::GetLastCreatedGLFWWindow(), static_cast<int>(key)) == GLFW_PRESS;
+    auto window = Window::GetLastCreatedGLFWWindow();
+
+    // No window when running headless
+    return window && glfwGetKey(window, static_cast<int>(key)) == GLFW_PRESS;
 }
 
 bool IsKeyReleased(Key key)
 {
-    return glfwGetKey(Window::GetLastCreatedGLFWWindow(), static_cast<int>(key)) == GLFW_RELEASE;
+    auto window = Window::GetLastCreatedGLFWWindow();
+
+    // No window when running headless
+    return window && glfwGetKey(window, static_cast<int>(key)) == GLFW_RELEASE;
 }
 
 bool IsKeyRepeated(Key key)
 {
-    return glfwGetKey(Window::GetLastCreatedGLFWWindow(), static_cast<int>(key)) == GLFW_REPEAT;
+    auto window = Window::GetLastCreatedGLFWWindow();
+
+    // No window when running headless
+    return window && glfwGetKey(window, static_cast<int>(key)) == GLFW_REPEAT;
 }
 
 }
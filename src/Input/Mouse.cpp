@@ -8,33 +8,44 @@ namespace Mouse
 
 void SetCursorVisible(bool visible)
 {
-    glfwSetInputMode(Window::GetLastCreatedGLFWWindow(), GLFW_CURSOR, visible ? GLFW_CURSOR_NORMAL : GLFW_CURSOR_DISABLED);
+    // No window when running headless
+    if(auto window = Window::GetLastCreatedGLFWWindow())
+        glfwSetInputMode(window, GLFW_CURSOR, visible ? GLFW_CURSOR_NORMAL : GLFW_CURSOR_DISABLED);
 }
 
 void SetPosition(const glm::vec2& pos)
 {
-    glfwSetCursorPos(Window::GetLastCreatedGLFWWindow(), pos.x, pos.y);
+    if(auto window = Window::GetLastCreatedGLFWWindow())
+        glfwSetCursorPos(window, pos.x, pos.y);
 }
 
 bool IsButtonPressed(Button button)
 {
-    return glfwGetMouseButton(Window::GetLastCreatedGLFWWindow(), static_cast<int>(button)) == GLFW_PRESS;
+    auto window = Window::GetLastCreatedGLFWWindow();
+
+    return window && glfwGetMouseButton(window, static_cast<int>(button)) == GLFW_PRESS;
 }
 
 bool IsButtonReleased(Button button)
 {
-    return glfwGetMouseButton(Window::GetLastCreatedGLFWWindow(), static_cast<int>(button)) == GLFW_RELEASE;
+    auto window = Window::GetLastCreatedGLFWWindow();
+
+    return window && glfwGetMouseButton(window, static_cast<int>(button)) == GLFW_RELEASE;
 }
 
 bool IsButtonRepeated(Button button)
 {
-    return glfwGetMouseButton(Window::GetLastCreatedGLFWWindow(), static_cast<int>(button)) == GLFW_REPEAT;
+    auto window = Window::GetLastCreatedGLFWWindow();
+
+    return window && glfwGetMouseButton(window, static_cast<int>(button)) == GLFW_REPEAT;
 }
 
 glm::vec2 GetPosition()
 {
-    double x, y;
-    glfwGetCursorPos(Window::GetLastCreatedGLFWWindow(), &x, &y);
+    double x = 0.0, y = 0.0;
+
+    if(auto window = Window::GetLastCreatedGLFWWindow())
+        glfwGetCursorPos(window, &x, &y);
 
     return { x, y };
 }
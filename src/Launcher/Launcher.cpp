@@ -7,15 +7,42 @@ Launcher::Launcher(const lustra::Config& config) : lustra::Application(config)
 
 void Launcher::Init()
 {
-    
+    // Windowed runs keep the launcher empty, a headless run needs a scene to exercise
+    if(!config.headless)
+        return;
+
+    lustra::PhysicsManager::Get().Init();
+
+    SetupAssetManager();
+
+    deferredRenderer = std::make_shared<lustra::DeferredRenderer>();
+
+    auto mainScenePath = 
+        lustra::AssetManager::Get().GetAssetPath<lustra::SceneAsset>(config.mainScene, true);
+
+    if(std::filesystem::exists(mainScenePath))
+        scene = lustra::AssetManager::Get().Load<lustra::SceneAsset>(mainScenePath)->scene;
+    else
+        scene = std::make_shared<lustra::Scene>();
+
+    scene->SetRenderer(deferredRenderer);
+
+    scene->Start();
+    scene->SetIsRunning(true);
 }
 
 void Launcher::Update(float deltaTime)
 {
-    
+    if(scene)
+        scene->Update(deltaTime);
 }
 
 void Launcher::Render()
 {
-    
+    if(!scene)
+        return;
+
+    scene->Draw();
+
+    lustra::Renderer::Get().Present();
 }
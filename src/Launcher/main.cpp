@@ -1,8 +1,25 @@
 #include <Launcher.hpp>
 
-int main()
+#include <cstdlib>
+#include <string_view>
+
+int main(int argc, char** argv)
 {
-    Launcher launcher(lustra::Config::Load("config.json"));
+    auto config = lustra::Config::Load("config.json");
+
+    // --headless [frames]: no window and no GPU, for CI runs
+    for(int i = 1; i < argc; i++)
+    {
+        if(std::string_view(argv[i]) == "--headless")
+        {
+            config.headless = true;
+
+            if(i + 1 < argc)
+                config.headlessFramesNum = std::strtoull(argv[++i], nullptr, 10);
+        }
+    }
+
+    Launcher launcher(config);
 
     launcher.Run();
 }
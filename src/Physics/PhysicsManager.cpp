@@ -18,6 +18,7 @@ void PhysicsManager::Init()
     JPH::RegisterTypes();
 
     collisionListener = std::make_unique<CollisionListener>();
+    activationListener = std::make_unique<ActivationListener>();
 
     tempAllocator = std::make_unique<JPH::TempAllocatorImpl>(10 * 1024 * 1024);
 
@@ -38,6 +39,7 @@ void PhysicsManager::Init()
     );
 
     physicsSystem.SetContactListener(collisionListener.get());
+    physicsSystem.SetBodyActivationListener(activationListener.get());
 }
 
 void PhysicsManager::Update(float deltaTime)
@@ -78,4 +80,10 @@ JPH::BodyInterface& PhysicsManager::GetBodyInterface()
     return physicsSystem.GetBodyInterface();
 }
 
+void PhysicsManager::TakeDeactivatedBodies(JPH::BodyIDVector& bodies)
+{
+    if(activationListener)
+        activationListener->TakeDeactivatedBodies(bodies);
+}
+
 }
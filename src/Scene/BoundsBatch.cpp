@@ -0,0 +1,263 @@
+#include <BoundsBatch.hpp>
+
+#include <bit>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define LUSTRA_CULLING_SIMD
+
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #define LUSTRA_TARGET_AVX2
+    #else
+        #define LUSTRA_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#endif
+
+namespace lustra
+{
+
+BoundsBatch::BoundsBatch(std::pmr::memory_resource* resource)
+    : minX(resource), minY(resource), minZ(resource),
+      maxX(resource), maxY(resource), maxZ(resource)
+{
+}
+
+void BoundsBatch::Add(const AABB& bounds)
+{
+    minX.push_back(bounds.min.x);
+    minY.push_back(bounds.min.y);
+    minZ.push_back(bounds.min.z);
+
+    maxX.push_back(bounds.max.x);
+    maxY.push_back(bounds.max.y);
+    maxZ.push_back(bounds.max.z);
+}
+
+void BoundsBatch::Reserve(size_t size)
+{
+    for(auto array : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ })
+        array->reserve(size);
+}
+
+void BoundsBatch::Clear()
+{
+    for(auto array : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ })
+        array->clear();
+}
+
+size_t BoundsBatch::GetSize() const
+{
+    return minX.size();
+}
+
+namespace
+{
+
+// Outside if the box's center is further behind a plane than the box reaches towards it
+size_t CullScalar(const Frustum& frustum, const BoundsBatch& batch, size_t begin, size_t end, uint8_t* visible)
+{
+    size_t visibleNum = 0;
+
+    for(size_t i = begin; i < end; i++)
+    {
+        float centerX = (batch.minX[i] + batch.maxX[i]) * 0.5f;
+        float centerY = (batch.minY[i] + batch.maxY[i]) * 0.5f;
+        float centerZ = (batch.minZ[i] + batch.maxZ[i]) * 0.5f;
+
+        float extentX = (batch.maxX[i] - batch.minX[i]) * 0.5f;
+        float extentY = (batch.maxY[i] - batch.minY[i]) * 0.5f;
+        float extentZ = (batch.maxZ[i] - batch.minZ[i]) * 0.5f;
+
+        bool outside = false;
+
+        for(auto& plane : frustum.planes)
+        {
+            float distance = plane.x * centerX + plane.y * centerY + plane.z * centerZ + plane.w;
+            float radius = std::abs(plane.x) * extentX + std::abs(plane.y) * extentY + std::abs(plane.z) * extentZ;
+
+            outside |= distance + radius < 0.0f;
+        }
+
+        visible[i] = !outside;
+        visibleNum += !outside;
+    }
+
+    return visibleNum;
+}
+
+#ifdef LUSTRA_CULLING_SIMD
+
+// Four boxes per iteration
+size_t CullSSE(const Frustum& frustum, const BoundsBatch& batch, size_t begin, size_t end, uint8_t* visible)
+{
+    size_t visibleNum = 0;
+    size_t i = begin;
+
+    auto half = _mm_set1_ps(0.5f);
+    auto sign = _mm_set1_ps(-0.0f);
+
+    for(; i + 4 <= end; i += 4)
+    {
+        auto minX = _mm_loadu_ps(batch.minX.data() + i);
+        auto minY = _mm_loadu_ps(batch.minY.data() + i);
+        auto minZ = _mm_loadu_ps(batch.minZ.data() + i);
+
+        auto maxX = _mm_loadu_ps(batch.maxX.data() + i);
+        auto maxY = _mm_loadu_ps(batch.maxY.data() + i);
+        auto maxZ = _mm_loadu_ps(batch.maxZ.data() + i);
+
+        auto centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+        auto centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+        auto centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+
+        auto extentX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+        auto extentY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+        auto extentZ = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+        auto outside = _mm_setzero_ps();
+
+        for(auto& plane : frustum.planes)
+        {
+            auto normalX = _mm_set1_ps(plane.x);
+            auto normalY = _mm_set1_ps(plane.y);
+            auto normalZ = _mm_set1_ps(plane.z);
+
+            auto distance = _mm_add_ps(
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX, centerX), _mm_mul_ps(normalY, centerY)), _mm_mul_ps(normalZ, centerZ)),
+                _mm_set1_ps(plane.w)
+            );
+
+            auto radius = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign, normalX), extentX), _mm_mul_ps(_mm_andnot_ps(sign, normalY), extentY)),
+                _mm_mul_ps(_mm_andnot_ps(sign, normalZ), extentZ)
+            );
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+        }
+
+        unsigned mask = ~_mm_movemask_ps(outside) & 0xF;
+
+        for(int lane = 0; lane < 4; lane++)
+            visible[i + lane] = (mask >> lane) & 1;
+
+        visibleNum += std::popcount(mask);
+    }
+
+    return visibleNum + CullScalar(frustum, batch, i, end, visible);
+}
+
+// Eight boxes per iteration, the rest goes through the SSE path
+LUSTRA_TARGET_AVX2
+size_t CullAVX2(const Frustum& frustum, const BoundsBatch& batch, size_t begin, size_t end, uint8_t* visible)
+{
+    size_t visibleNum = 0;
+    size_t i = begin;
+
+    auto half = _mm256_set1_ps(0.5f);
+    auto sign = _mm256_set1_ps(-0.0f);
+
+    for(; i + 8 <= end; i += 8)
+    {
+        auto minX = _mm256_loadu_ps(batch.minX.data() + i);
+        auto minY = _mm256_loadu_ps(batch.minY.data() + i);
+        auto minZ = _mm256_loadu_ps(batch.minZ.data() + i);
+
+        auto maxX = _mm256_loadu_ps(batch.maxX.data() + i);
+        auto maxY = _mm256_loadu_ps(batch.maxY.data() + i);
+        auto maxZ = _mm256_loadu_ps(batch.maxZ.data() + i);
+
+        auto centerX = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+        auto centerY = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+        auto centerZ = _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half);
+
+        auto extentX = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+        auto extentY = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+        auto extentZ = _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half);
+
+        auto outside = _mm256_setzero_ps();
+
+        for(auto& plane : frustum.planes)
+        {
+            auto normalX = _mm256_set1_ps(plane.x);
+            auto normalY = _mm256_set1_ps(plane.y);
+            auto normalZ = _mm256_set1_ps(plane.z);
+
+            auto distance = _mm256_fmadd_ps(normalZ, centerZ,
+                _mm256_fmadd_ps(normalY, centerY, _mm256_fmadd_ps(normalX, centerX, _mm256_set1_ps(plane.w))));
+
+            auto radius = _mm256_fmadd_ps(_mm256_andnot_ps(sign, normalZ), extentZ,
+                _mm256_fmadd_ps(_mm256_andnot_ps(sign, normalY), extentY, _mm256_mul_ps(_mm256_andnot_ps(sign, normalX), extentX)));
+
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+
+        unsigned mask = ~_mm256_movemask_ps(outside) & 0xFF;
+
+        for(int lane = 0; lane < 8; lane++)
+            visible[i + lane] = (mask >> lane) & 1;
+
+        visibleNum += std::popcount(mask);
+    }
+
+    return visibleNum + CullSSE(frustum, batch, i, end, visible);
+}
+
+#endif
+
+}
+
+CullingKernel::CullingKernel()
+{
+    // Same CPU checks as the transform kernel
+    for(auto candidate : { InstructionSet::AVX2, InstructionSet::SSE })
+    {
+        if(TransformKernel::Get().IsSupported(candidate))
+        {
+            bestInstructionSet = candidate;
+            break;
+        }
+    }
+
+    SetInstructionSet(bestInstructionSet);
+}
+
+size_t CullingKernel::Cull(const Frustum& frustum, const BoundsBatch& batch, size_t begin, size_t end, uint8_t* visible) const
+{
+    return cull(frustum, batch, begin, end, visible);
+}
+
+size_t CullingKernel::Cull(const Frustum& frustum, const BoundsBatch& batch, uint8_t* visible) const
+{
+    return cull(frustum, batch, 0, batch.GetSize(), visible);
+}
+
+void CullingKernel::SetInstructionSet(InstructionSet instructionSet)
+{
+    if(!IsSupported(instructionSet))
+        instructionSet = bestInstructionSet;
+
+    this->instructionSet = instructionSet;
+
+    switch(instructionSet)
+    {
+#ifdef LUSTRA_CULLING_SIMD
+    case InstructionSet::AVX2: cull = CullAVX2; break;
+    case InstructionSet::SSE: cull = CullSSE; break;
+#endif
+    default: cull = CullScalar; break;
+    }
+}
+
+CullingKernel::InstructionSet CullingKernel::GetInstructionSet() const
+{
+    return instructionSet;
+}
+
+bool CullingKernel::IsSupported(InstructionSet instructionSet) const
+{
+    return instructionSet <= bestInstructionSet;
+}
+
+}
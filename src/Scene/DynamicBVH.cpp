@@ -0,0 +1,557 @@
+#include <DynamicBVH.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace lustra
+{
+
+namespace
+{
+
+// Depth-first traversal stack, a balanced tree never gets close to the
+// inline capacity but a degenerate one still works
+class NodeStack
+{
+public:
+    void Push(int32_t node)
+    {
+        if(size < inlineNodes.size())
+            inlineNodes[size] = node;
+        else
+            overflow.push_back(node);
+
+        size++;
+    }
+
+    int32_t Pop()
+    {
+        size--;
+
+        if(size < inlineNodes.size())
+            return inlineNodes[size];
+
+        auto node = overflow.back();
+        overflow.pop_back();
+
+        return node;
+    }
+
+    bool IsEmpty() const
+    {
+        return size == 0;
+    }
+
+private:
+    std::array<int32_t, 64> inlineNodes;
+    std::vector<int32_t> overflow;
+
+    size_t size = 0;
+};
+
+}
+
+DynamicBVH::DynamicBVH(float margin)
+    : margin(margin)
+{
+}
+
+int32_t DynamicBVH::Insert(const AABB& bounds, entt::entity entity)
+{
+    auto proxy = AllocateNode();
+
+    nodes[proxy].bounds = bounds.Expanded(margin);
+    nodes[proxy].entity = entity;
+    nodes[proxy].height = 0;
+
+    InsertLeaf(proxy);
+
+    proxiesNum++;
+
+    return proxy;
+}
+
+void DynamicBVH::Remove(int32_t proxy)
+{
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+
+    proxiesNum--;
+}
+
+bool DynamicBVH::Move(int32_t proxy, const AABB& bounds)
+{
+    auto fatBounds = bounds.Expanded(margin);
+
+    // Still inside, and the old box isn't much larger than needed anymore
+    if(nodes[proxy].bounds.Contains(bounds) && fatBounds.Expanded(4.0f * margin).Contains(nodes[proxy].bounds))
+        return false;
+
+    RemoveLeaf(proxy);
+
+    nodes[proxy].bounds = fatBounds;
+
+    InsertLeaf(proxy);
+
+    return true;
+}
+
+void DynamicBVH::Clear()
+{
+    nodes.clear();
+
+    root = nullNode;
+    freeList = nullNode;
+
+    proxiesNum = 0;
+}
+
+void DynamicBVH::Query(const AABB& box, FunctionRef<void(entt::entity)> callback) const
+{
+    if(root == nullNode)
+        return;
+
+    NodeStack stack;
+    stack.Push(root);
+
+    while(!stack.IsEmpty())
+    {
+        auto& node = nodes[stack.Pop()];
+
+        if(!node.bounds.Intersects(box))
+            continue;
+
+        if(node.IsLeaf())
+            callback(node.entity);
+        else
+        {
+            stack.Push(node.left);
+            stack.Push(node.right);
+        }
+    }
+}
+
+void DynamicBVH::Query(const Sphere& sphere, FunctionRef<void(entt::entity)> callback) const
+{
+    if(root == nullNode)
+        return;
+
+    NodeStack stack;
+    stack.Push(root);
+
+    while(!stack.IsEmpty())
+    {
+        auto& node = nodes[stack.Pop()];
+
+        if(!sphere.Intersects(node.bounds))
+            continue;
+
+        if(node.IsLeaf())
+            callback(node.entity);
+        else
+        {
+            stack.Push(node.left);
+            stack.Push(node.right);
+        }
+    }
+}
+
+void DynamicBVH::Query(const Frustum& frustum, FunctionRef<void(entt::entity)> callback) const
+{
+    if(root == nullNode)
+        return;
+
+    NodeStack stack;
+    stack.Push(root);
+
+    while(!stack.IsEmpty())
+    {
+        auto index = stack.Pop();
+        auto& node = nodes[index];
+
+        auto result = frustum.Classify(node.bounds);
+
+        if(result == Frustum::Result::Outside)
+            continue;
+
+        // Nothing below a node inside the frustum needs testing
+        if(result == Frustum::Result::Inside || node.IsLeaf())
+            ReportSubtree(index, callback);
+        else
+        {
+            stack.Push(node.left);
+            stack.Push(node.right);
+        }
+    }
+}
+
+void DynamicBVH::CastRay(const Ray& ray, float maxDistance, FunctionRef<float(entt::entity, float)> callback) const
+{
+    float distance;
+
+    if(root == nullNode || !ray.Intersects(nodes[root].bounds, maxDistance, distance))
+        return;
+
+    NodeStack stack;
+    stack.Push(root);
+
+    while(!stack.IsEmpty())
+    {
+        auto& node = nodes[stack.Pop()];
+
+        // Tested again, maxDistance may have shrunk since the node was pushed
+        if(!ray.Intersects(node.bounds, maxDistance, distance))
+            continue;
+
+        if(node.IsLeaf())
+        {
+            maxDistance = callback(node.entity, distance);
+
+            if(maxDistance <= 0.0f)
+                return;
+
+            continue;
+        }
+
+        float leftDistance, rightDistance;
+
+        bool hitLeft = ray.Intersects(nodes[node.left].bounds, maxDistance, leftDistance);
+        bool hitRight = ray.Intersects(nodes[node.right].bounds, maxDistance, rightDistance);
+
+        // The nearer child is pushed last so it's visited first
+        if(hitLeft && hitRight)
+        {
+            bool leftFirst = leftDistance <= rightDistance;
+
+            stack.Push(leftFirst ? node.right : node.left);
+            stack.Push(leftFirst ? node.left : node.right);
+        }
+        else if(hitLeft)
+            stack.Push(node.left);
+        else if(hitRight)
+            stack.Push(node.right);
+    }
+}
+
+const AABB& DynamicBVH::GetFatBounds(int32_t proxy) const
+{
+    return nodes[proxy].bounds;
+}
+
+entt::entity DynamicBVH::GetEntity(int32_t proxy) const
+{
+    return nodes[proxy].entity;
+}
+
+size_t DynamicBVH::GetProxiesNum() const
+{
+    return proxiesNum;
+}
+
+int32_t DynamicBVH::GetHeight() const
+{
+    return root == nullNode ? 0 : nodes[root].height;
+}
+
+int32_t DynamicBVH::AllocateNode()
+{
+    int32_t node;
+
+    if(freeList != nullNode)
+    {
+        node = freeList;
+        freeList = nodes[node].parent;
+
+        nodes[node] = Node{};
+    }
+    else
+    {
+        node = (int32_t)nodes.size();
+        nodes.emplace_back();
+    }
+
+    return node;
+}
+
+void DynamicBVH::FreeNode(int32_t node)
+{
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    nodes[node].entity = entt::null;
+
+    freeList = node;
+}
+
+void DynamicBVH::InsertLeaf(int32_t leaf)
+{
+    if(root == nullNode)
+    {
+        root = leaf;
+        nodes[root].parent = nullNode;
+
+        return;
+    }
+
+    auto leafBounds = nodes[leaf].bounds;
+
+    // Walks down to the sibling that grows the tree's surface area the least
+    auto index = root;
+
+    while(!nodes[index].IsLeaf())
+    {
+        auto& node = nodes[index];
+
+        float area = node.bounds.GetSurfaceArea();
+        float combinedArea = node.bounds.Merged(leafBounds).GetSurfaceArea();
+
+        // Pairing with this node under a new parent
+        float cost = 2.0f * combinedArea;
+
+        // Every ancestor of a deeper sibling grows by the same amount
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child)
+        {
+            auto& childNode = nodes[child];
+
+            float merged = childNode.bounds.Merged(leafBounds).GetSurfaceArea();
+
+            return childNode.IsLeaf()
+                ? merged + inheritanceCost
+                : merged - childNode.bounds.GetSurfaceArea() + inheritanceCost;
+        };
+
+        float leftCost = descendCost(node.left);
+        float rightCost = descendCost(node.right);
+
+        if(cost < leftCost && cost < rightCost)
+            break;
+
+        index = leftCost < rightCost ? node.left : node.right;
+    }
+
+    auto sibling = index;
+
+    auto oldParent = nodes[sibling].parent;
+    auto newParent = AllocateNode();
+
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].bounds = leafBounds.Merged(nodes[sibling].bounds);
+    nodes[newParent].height = nodes[sibling].height + 1;
+
+    if(oldParent != nullNode)
+    {
+        if(nodes[oldParent].left == sibling)
+            nodes[oldParent].left = newParent;
+        else
+            nodes[oldParent].right = newParent;
+    }
+    else
+        root = newParent;
+
+    nodes[newParent].left = sibling;
+    nodes[newParent].right = leaf;
+
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    // Refits and rebalances the ancestors
+    index = nodes[leaf].parent;
+
+    while(index != nullNode)
+    {
+        index = Balance(index);
+
+        auto& node = nodes[index];
+
+        node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+        node.bounds = nodes[node.left].bounds.Merged(nodes[node.right].bounds);
+
+        index = node.parent;
+    }
+}
+
+void DynamicBVH::RemoveLeaf(int32_t leaf)
+{
+    if(leaf == root)
+    {
+        root = nullNode;
+        return;
+    }
+
+    auto parent = nodes[leaf].parent;
+    auto grandParent = nodes[parent].parent;
+    auto sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    FreeNode(parent);
+
+    if(grandParent == nullNode)
+    {
+        root = sibling;
+        nodes[sibling].parent = nullNode;
+
+        return;
+    }
+
+    // The sibling takes the parent's place
+    if(nodes[grandParent].left == parent)
+        nodes[grandParent].left = sibling;
+    else
+        nodes[grandParent].right = sibling;
+
+    nodes[sibling].parent = grandParent;
+
+    auto index = grandParent;
+
+    while(index != nullNode)
+    {
+        index = Balance(index);
+
+        auto& node = nodes[index];
+
+        node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+        node.bounds = nodes[node.left].bounds.Merged(nodes[node.right].bounds);
+
+        index = node.parent;
+    }
+}
+
+int32_t DynamicBVH::Balance(int32_t indexA)
+{
+    auto& a = nodes[indexA];
+
+    if(a.IsLeaf() || a.height < 2)
+        return indexA;
+
+    auto indexB = a.left;
+    auto indexC = a.right;
+
+    auto& b = nodes[indexB];
+    auto& c = nodes[indexC];
+
+    int32_t balance = c.height - b.height;
+
+    // Promotes C, or B below, and hands A its taller child
+    if(balance > 1)
+    {
+        auto indexF = c.left;
+        auto indexG = c.right;
+
+        auto& f = nodes[indexF];
+        auto& g = nodes[indexG];
+
+        c.left = indexA;
+        c.parent = a.parent;
+        a.parent = indexC;
+
+        if(c.parent != nullNode)
+        {
+            if(nodes[c.parent].left == indexA)
+                nodes[c.parent].left = indexC;
+            else
+                nodes[c.parent].right = indexC;
+        }
+        else
+            root = indexC;
+
+        if(f.height > g.height)
+        {
+            c.right = indexF;
+            a.right = indexG;
+            g.parent = indexA;
+
+            a.bounds = b.bounds.Merged(g.bounds);
+            c.bounds = a.bounds.Merged(f.bounds);
+
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        }
+        else
+        {
+            c.right = indexG;
+            a.right = indexF;
+            f.parent = indexA;
+
+            a.bounds = b.bounds.Merged(f.bounds);
+            c.bounds = a.bounds.Merged(g.bounds);
+
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+
+        return indexC;
+    }
+
+    if(balance < -1)
+    {
+        auto indexD = b.left;
+        auto indexE = b.right;
+
+        auto& d = nodes[indexD];
+        auto& e = nodes[indexE];
+
+        b.left = indexA;
+        b.parent = a.parent;
+        a.parent = indexB;
+
+        if(b.parent != nullNode)
+        {
+            if(nodes[b.parent].left == indexA)
+                nodes[b.parent].left = indexB;
+            else
+                nodes[b.parent].right = indexB;
+        }
+        else
+            root = indexB;
+
+        if(d.height > e.height)
+        {
+            b.right = indexD;
+            a.left = indexE;
+            e.parent = indexA;
+
+            a.bounds = c.bounds.Merged(e.bounds);
+            b.bounds = a.bounds.Merged(d.bounds);
+
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        }
+        else
+        {
+            b.right = indexE;
+            a.left = indexD;
+            d.parent = indexA;
+
+            a.bounds = c.bounds.Merged(d.bounds);
+            b.bounds = a.bounds.Merged(e.bounds);
+
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+
+        return indexB;
+    }
+
+    return indexA;
+}
+
+void DynamicBVH::ReportSubtree(int32_t node, FunctionRef<void(entt::entity)> callback) const
+{
+    NodeStack stack;
+    stack.Push(node);
+
+    while(!stack.IsEmpty())
+    {
+        auto& current = nodes[stack.Pop()];
+
+        if(current.IsLeaf())
+            callback(current.entity);
+        else
+        {
+            stack.Push(current.left);
+            stack.Push(current.right);
+        }
+    }
+}
+
+}
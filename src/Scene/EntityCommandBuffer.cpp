@@ -0,0 +1,82 @@
+#include <EntityCommandBuffer.hpp>
+#include <Entity.hpp>
+#include <Profiler.hpp>
+
+namespace lustra
+{
+
+EntityCommandBuffer::EntityCommandBuffer(Scene* scene)
+    : scene(scene), ownerThread(std::this_thread::get_id())
+{
+}
+
+entt::entity EntityCommandBuffer::CreateEntity()
+{
+    assert(std::this_thread::get_id() == ownerThread && "Entities can only be created by the thread owning the scene");
+
+    return scene->GetRegistry().create();
+}
+
+entt::entity EntityCommandBuffer::CloneEntity(entt::entity entity)
+{
+    assert(std::this_thread::get_id() == ownerThread && "Entities can only be cloned by the thread owning the scene");
+
+    return scene->CloneEntity({ entity, scene });
+}
+
+void EntityCommandBuffer::RemoveEntity(entt::entity entity)
+{
+    std::lock_guard lock(mutex);
+
+    entityCommands.push_back({ EntityCommand::Type::Remove, entity, entt::null });
+}
+
+void EntityCommandBuffer::ReparentEntity(entt::entity child, entt::entity parent)
+{
+    std::lock_guard lock(mutex);
+
+    entityCommands.push_back({ EntityCommand::Type::Reparent, child, parent });
+}
+
+void EntityCommandBuffer::Playback()
+{
+    LUSTRA_PROFILE_ZONE("EntityCommandBuffer::Playback");
+
+    std::lock_guard lock(mutex);
+
+    auto& registry = scene->GetRegistry();
+
+    for(auto& commands : componentCommands)
+        if(!commands->IsEmpty())
+            commands->Playback(registry);
+
+    auto playback = [&](EntityCommand::Type type, auto&& function)
+    {
+        for(auto& command : entityCommands)
+            if(command.type == type && registry.valid(command.entity))
+                function(command);
+    };
+
+    playback(EntityCommand::Type::Reparent, [&](const EntityCommand& command)
+    {
+        scene->ReparentEntity({ command.entity, scene }, { command.other, scene });
+    });
+
+    // Removing the same entity twice only removes it once, valid() is checked every time
+    playback(EntityCommand::Type::Remove, [&](const EntityCommand& command)
+    {
+        scene->RemoveEntity({ command.entity, scene });
+    });
+
+    entityCommands.clear();
+}
+
+bool EntityCommandBuffer::IsEmpty()
+{
+    std::lock_guard lock(mutex);
+
+    return entityCommands.empty()
+        && std::all_of(componentCommands.begin(), componentCommands.end(), [](auto& commands) { return commands->IsEmpty(); });
+}
+
+}
@@ -1,6 +1,9 @@
 #include <Scene.hpp>
 #include <Entity.hpp>
 #include <ScriptManager.hpp>
+#include <Profiler.hpp>
+#include <TransformBatch.hpp>
+#include <BoundsBatch.hpp>
 
 namespace lustra
 {
@@ -9,18 +12,51 @@ Scene::Scene(std::shared_ptr<RendererBase> renderer)
     : renderer(renderer)
 {
     Setup();
+    SetupSystems();
 }
 
 Scene::~Scene()
 {
     EventManager::Get().RemoveListener(Event::Type::WindowResize, this);
-    EventManager::Get().RemoveListener(Event::Type::Collision, this);
+    EventBus::Get().RemoveListener<CollisionEvent>(this);
+
+    registry.on_construct<WorldTransformComponent>().disconnect(this);
+    registry.on_destroy<WorldTransformComponent>().disconnect(this);
+    registry.on_destroy<TransformComponent>().disconnect(this);
+
+    registry.on_construct<NameComponent>().disconnect(this);
+    registry.on_update<NameComponent>().disconnect(this);
+    registry.on_destroy<NameComponent>().disconnect(this);
+
+    registry.on_construct<WorldBoundsComponent>().disconnect(this);
+    registry.on_destroy<WorldBoundsComponent>().disconnect(this);
+
+    registry.on_construct<RigidBodyComponent>().disconnect(this);
+    registry.on_update<RigidBodyComponent>().disconnect(this);
 }
 
 void Scene::Setup()
 {
     EventManager::Get().AddListener(Event::Type::WindowResize, this);
-    EventManager::Get().AddListener(Event::Type::Collision, this);
+    EventBus::Get().AddListener<CollisionEvent>(this);
+
+    // Created or destroyed entities invalidate the sorted hierarchy
+    registry.on_construct<WorldTransformComponent>().connect<&Scene::OnWorldTransformChanged>(this);
+    registry.on_destroy<WorldTransformComponent>().connect<&Scene::OnWorldTransformChanged>(this);
+    registry.on_destroy<TransformComponent>().connect<&Scene::OnWorldTransformChanged>(this);
+
+    // Keeps the name index in sync, in place renames have to be followed by a patch
+    registry.on_construct<NameComponent>().connect<&Scene::OnNameChanged>(this);
+    registry.on_update<NameComponent>().connect<&Scene::OnNameChanged>(this);
+    registry.on_destroy<NameComponent>().connect<&Scene::OnNameRemoved>(this);
+
+    // Every bounds component owns a leaf in the BVH
+    registry.on_construct<WorldBoundsComponent>().connect<&Scene::OnBoundsCreated>(this);
+    registry.on_destroy<WorldBoundsComponent>().connect<&Scene::OnBoundsRemoved>(this);
+
+    // New bodies have to be mapped back to their entities
+    registry.on_construct<RigidBodyComponent>().connect<&Scene::OnRigidBodyChanged>(this);
+    registry.on_update<RigidBodyComponent>().connect<&Scene::OnRigidBodyChanged>(this);
 
     if(!lightsBuffer)
     {
@@ -65,49 +101,41 @@ void Scene::Start()
         /* if(script.start)
             script.start(); */
     });
+
+    commands.Playback();
 }
 
 void Scene::Update(float deltaTime)
 {
-    InputManager::Get().Update();
+    LUSTRA_PROFILE_ZONE("Scene::Update");
 
-    registry.view<ScriptComponent>().each([&](auto entity, auto& script)
-    {
-        if(script.script)
-        {
-            ScriptManager::Get().ExecuteFunction(
-                script.script,
-                "void Update(float)",
-                [&](auto context)
-                {
-                    context->SetArgFloat(0, deltaTime);
-                },
-                script.moduleIndex
-            );
-        }
+    updateSystems.Update(deltaTime);
 
-        /* if(script.update)
-            script.update(Entity{ entity, this }, deltaTime); */
-    });
-
-    if(updatePhysics)
-        PhysicsManager::Get().Update(deltaTime);
+    // Whatever the collision listeners and the user systems recorded
+    commands.Playback();
 }
 
 void Scene::Draw(LLGL::RenderTarget* renderTarget)
 {
-    RenderToShadowMap();
+    LUSTRA_PROFILE_ZONE("Scene::Draw");
+
+    UpdateWorldTransforms();
+    UpdateBounds();
+
+    DrawList drawList(FrameArena::Get().GetResource());
+
+    GatherDrawList(drawList);
+
+    RenderToShadowMap(drawList);
 
-    SetupCamera();
-    SetupLights();
-    SetupShadows();
+    drawSystems.Update(0.0f);
 
     Renderer::Get().Begin();
 
     UpdateLightsBuffer();
     UpdateShadowsBuffer();
 
-    RenderMeshes();
+    RenderMeshes(drawList);
     
     Renderer::Get().End();
 
@@ -116,6 +144,86 @@ void Scene::Draw(LLGL::RenderTarget* renderTarget)
     ApplyPostProcessing(renderTarget);
 }
 
+void Scene::SetupSystems()
+{
+    // Input and scripts talk to GLFW and AngelScript, both want the main thread.
+    // A script can touch anything, so nothing runs next to it
+    updateSystems.AddSystem("Input", [](float)
+    {
+        InputManager::Get().Update();
+    }).Writes<InputManager>().OnMainThread();
+
+    updateSystems.AddSystem("Scripts", [this](float deltaTime)
+    {
+        registry.view<ScriptComponent>().each([&](auto entity, auto& script)
+        {
+            if(script.script)
+            {
+                ScriptManager::Get().ExecuteFunction(
+                    script.script,
+                    "void Update(float)",
+                    [&](auto context)
+                    {
+                        context->SetArgFloat(0, deltaTime);
+                    },
+                    script.moduleIndex
+                );
+            }
+
+            /* if(script.update)
+                script.update(Entity{ entity, this }, deltaTime); */
+        });
+    }).Exclusive().OnMainThread();
+
+    // So physics and rendering see this frame's entities
+    updateSystems.AddSystem("Commands", [this](float)
+    {
+        commands.Playback();
+    }).Exclusive().OnMainThread();
+
+    updateSystems.AddSystem("PushPhysicsTransforms", [this](float)
+    {
+        if(updatePhysics)
+            PushPhysicsTransforms();
+    }).Reads<TransformComponent, RigidBodyComponent>().Writes<PhysicsManager>();
+
+    updateSystems.AddSystem("Physics", [this](float deltaTime)
+    {
+        if(updatePhysics)
+            PhysicsManager::Get().Update(deltaTime);
+    }).Writes<PhysicsManager>();
+
+    updateSystems.AddSystem("SyncPhysicsTransforms", [this](float)
+    {
+        if(updatePhysics)
+            SyncPhysicsTransforms();
+    }).Reads<RigidBodyComponent>().Writes<PhysicsManager, TransformComponent>();
+
+    // Collisions posted during the step, the listeners are scripts too
+    updateSystems.AddSystem("Collisions", [this](float)
+    {
+        if(updatePhysics)
+            EventBus::Get().Flush<CollisionEvent>();
+    }).Exclusive().OnMainThread();
+
+    // Camera and lights are gathered on the workers while the main thread sets up the shadows
+    drawSystems.AddSystem("Camera", [this](float)
+    {
+        SetupCamera();
+    }).Reads<TransformComponent, WorldTransformComponent, HierarchyComponent>().Writes<CameraComponent, Matrices>();
+
+    drawSystems.AddSystem("Lights", [this](float)
+    {
+        SetupLights();
+    }).Reads<LightComponent, TransformComponent, WorldTransformComponent, HierarchyComponent>().Writes<Light>();
+
+    // Loads the empty texture through AssetManager
+    drawSystems.AddSystem("Shadows", [this](float)
+    {
+        SetupShadows();
+    }).Reads<LightComponent, TransformComponent, WorldTransformComponent, HierarchyComponent>().Writes<Shadow>().OnMainThread();
+}
+
 void Scene::OnEvent(Event& event)
 {
     if(!isRunning)
@@ -145,33 +253,33 @@ void Scene::OnEvent(Event& event)
         }
         break;
 
-        case Event::Type::Collision:
-        {
-            auto collisionEvent = dynamic_cast<CollisionEvent*>(&event);
-
-            registry.view<ScriptComponent>().each([&](auto entity, auto& script)
-            {
-                if(script.script)
-                {
-                    ScriptManager::Get().ExecuteFunction(
-                        script.script,
-                        "void OnCollision(CollisionEvent@)",
-                        [&](auto context)
-                        {
-                            context->SetArgAddress(0, collisionEvent);
-                        },
-                        script.moduleIndex
-                    );
-                }
-            });
-        }
-        break;
-
         default:
             break;
     }
 }
 
+void Scene::OnEvent(CollisionEvent& event)
+{
+    if(!isRunning)
+        return;
+
+    registry.view<ScriptComponent>().each([&](auto entity, auto& script)
+    {
+        if(script.script)
+        {
+            ScriptManager::Get().ExecuteFunction(
+                script.script,
+                "void OnCollision(CollisionEvent@)",
+                [&](auto context)
+                {
+                    context->SetArgAddress(0, &event);
+                },
+                script.moduleIndex
+            );
+        }
+    });
+}
+
 void Scene::SetUpdatePhysics(bool updatePhysics)
 {
     this->updatePhysics = updatePhysics;
@@ -194,7 +302,7 @@ void Scene::ToggleIsRunning()
 
 void Scene::ReparentEntity(Entity child, Entity parent)
 {
-    static auto removeChild = [&](Entity child, Entity parent)
+    auto removeChild = [&](Entity child, Entity parent)
     {
         if(registry.valid(parent))
         {
@@ -211,6 +319,11 @@ void Scene::ReparentEntity(Entity child, Entity parent)
     auto& childHierarchy = child.GetOrAddComponent<HierarchyComponent>();
     auto prevParent = Entity(childHierarchy.parent, this);
 
+    if(auto world = registry.try_get<WorldTransformComponent>(child))
+        world->dirty = true;
+
+    hierarchyChanged = true;
+
     if(prevParent == parent)
     {
         childHierarchy.parent = entt::null;
@@ -242,6 +355,14 @@ void Scene::ReparentEntity(Entity child, Entity parent)
 
 void Scene::RemoveEntity(Entity entity)
 {
+    // The children become roots
+    if(auto hierarchy = registry.try_get<HierarchyComponent>(entity))
+        for(auto child : hierarchy->children)
+            if(auto world = registry.try_get<WorldTransformComponent>(child))
+                world->dirty = true;
+
+    hierarchyChanged = true;
+
     registry.destroy(entity);
 }
 
@@ -260,6 +381,8 @@ Entity Scene::CloneEntity(Entity entity)
             storage.push(clone, storage.value(entity));
     }
 
+    hierarchyChanged = true;
+
     return clone;
 }
 
@@ -270,15 +393,41 @@ Entity Scene::GetEntity(entt::id_type id)
 
 Entity Scene::GetEntity(const std::string& name)
 {
-    Entity ret{};
+    auto it = nameIndex.find(name);
+
+    if(it == nameIndex.end())
+        return {};
+
+    // A name changed in place without a patch is still under its old key
+    for(auto entity : it->second)
+        if(registry.get<NameComponent>(entity).name == name)
+            return { entity, this };
+
+    return {};
+}
+
+std::vector<Entity> Scene::GetEntities(const std::string& name)
+{
+    std::vector<Entity> entities;
+
+    auto it = nameIndex.find(name);
+
+    if(it == nameIndex.end())
+        return entities;
+
+    for(auto entity : it->second)
+        if(registry.get<NameComponent>(entity).name == name)
+            entities.emplace_back(entity, this);
+
+    return entities;
+}
 
-    registry.view<NameComponent>().each([&](auto entity, auto& component)
+void Scene::RenameEntity(Entity entity, const std::string& name)
+{
+    registry.patch<NameComponent>(entity, [&](auto& component)
     {
-        if(component.name == name)
-            ret = { entity, this };
+        component.name = name;
     });
-
-    return ret;
 }
 
 bool Scene::IsChildOf(Entity child, Entity parent)
@@ -326,11 +475,356 @@ glm::mat4 Scene::GetWorldTransform(entt::entity entity)
     return transformMatrix;
 }
 
+void Scene::UpdateWorldTransforms()
+{
+    LUSTRA_PROFILE_ZONE("Scene::UpdateWorldTransforms");
+
+    // Also catches entities that were loaded or cloned since the last call
+    auto uncachedView = registry.view<TransformComponent>(entt::exclude<WorldTransformComponent>);
+
+    FrameVector<entt::entity> uncached(uncachedView.begin(), uncachedView.end(), FrameArena::Get().GetResource());
+
+    for(auto entity : uncached)
+        registry.emplace<WorldTransformComponent>(entity);
+
+    if(hierarchyChanged)
+        SortHierarchy();
+
+    // Parents come before their children, so a single pass in order is enough
+    FrameVector<uint8_t> changed(hierarchyOrder.size(), 0, FrameArena::Get().GetResource());
+
+    size_t changedNum = 0;
+
+    for(size_t i = 0; i < hierarchyOrder.size(); i++)
+    {
+        auto [transform, world] = registry.get<TransformComponent, WorldTransformComponent>(hierarchyOrder[i]);
+
+        auto parent = hierarchyParents[i];
+
+        bool parentChanged = parent != noHierarchyParent && changed[parent];
+        bool localChanged = world.dirty || world.localVersion != transform.GetVersion();
+
+        if(parentChanged || localChanged)
+        {
+            changed[i] = true;
+            changedNum++;
+        }
+    }
+
+    if(!changedNum)
+        return;
+
+    // The batch keeps the same order, so every parent is composed before its children
+    TransformBatch batch(FrameArena::Get().GetResource());
+    batch.Reserve(changedNum);
+
+    for(size_t i = 0; i < hierarchyOrder.size(); i++)
+    {
+        if(!changed[i])
+            continue;
+
+        auto [transform, world] = registry.get<TransformComponent, WorldTransformComponent>(hierarchyOrder[i]);
+
+        auto parent = hierarchyParents[i];
+
+        batch.Add(
+            transform,
+            parent != noHierarchyParent ? &registry.get<WorldTransformComponent>(hierarchyOrder[parent]).transform : nullptr,
+            &world.transform
+        );
+
+        world.dirty = false;
+        world.localVersion = transform.GetVersion();
+        world.version++;
+    }
+
+    TransformKernel::Get().Compose(batch);
+}
+
+void Scene::UpdateBounds()
+{
+    LUSTRA_PROFILE_ZONE("Scene::UpdateBounds");
+
+    // Entities that lost their mesh or transform leave the tree
+    FrameVector<entt::entity> stale(FrameArena::Get().GetResource());
+
+    for(auto entity : registry.view<WorldBoundsComponent>())
+        if(!registry.all_of<MeshComponent, WorldTransformComponent>(entity))
+            stale.push_back(entity);
+
+    registry.remove<WorldBoundsComponent>(stale.begin(), stale.end());
+
+    auto unboundedView = registry.view<MeshComponent, WorldTransformComponent>(entt::exclude<WorldBoundsComponent>);
+
+    FrameVector<entt::entity> unbounded(unboundedView.begin(), unboundedView.end(), FrameArena::Get().GetResource());
+
+    for(auto entity : unbounded)
+        registry.emplace<WorldBoundsComponent>(entity);
+
+    auto view = registry.view<WorldBoundsComponent, WorldTransformComponent, MeshComponent>();
+
+    for(auto entity : view)
+    {
+        auto [bounds, world, mesh] = view.get<WorldBoundsComponent, WorldTransformComponent, MeshComponent>(entity);
+
+        // Also catches a model that was swapped or finished loading
+        auto modelBounds = mesh.model ? mesh.model->bounds : AABB{};
+        auto meshesNum = mesh.model ? mesh.model->meshes.size() : 0;
+
+        if(bounds.proxy != DynamicBVH::nullNode && bounds.worldVersion == world.version
+            && bounds.modelBounds == modelBounds && bounds.meshBounds.size() == meshesNum)
+            continue;
+
+        bounds.worldVersion = world.version;
+        bounds.modelBounds = modelBounds;
+
+        // Tighter than the model's box transformed as a whole
+        bounds.bounds = {};
+        bounds.meshBounds.resize(meshesNum);
+
+        for(size_t i = 0; i < meshesNum; i++)
+        {
+            bounds.meshBounds[i] = mesh.model->meshes[i]->GetBounds().Transformed(world.transform);
+            bounds.bounds.Merge(bounds.meshBounds[i]);
+        }
+
+        if(bounds.bounds.IsEmpty())
+        {
+            // Still findable by its position
+            glm::vec3 position(world.transform[3]);
+
+            bounds.bounds = { position, position };
+        }
+
+        if(bounds.proxy == DynamicBVH::nullNode)
+            bounds.proxy = bvh.Insert(bounds.bounds, entity);
+        else
+            bvh.Move(bounds.proxy, bounds.bounds);
+    }
+}
+
+void Scene::QueryBounds(const AABB& box, FunctionRef<void(entt::entity)> callback)
+{
+    bvh.Query(box, [&](entt::entity entity)
+    {
+        if(registry.get<WorldBoundsComponent>(entity).bounds.Intersects(box))
+            callback(entity);
+    });
+}
+
+void Scene::QueryBounds(const Sphere& sphere, FunctionRef<void(entt::entity)> callback)
+{
+    bvh.Query(sphere, [&](entt::entity entity)
+    {
+        if(sphere.Intersects(registry.get<WorldBoundsComponent>(entity).bounds))
+            callback(entity);
+    });
+}
+
+void Scene::QueryBounds(const Frustum& frustum, FunctionRef<void(entt::entity)> callback)
+{
+    bvh.Query(frustum, [&](entt::entity entity)
+    {
+        if(frustum.Intersects(registry.get<WorldBoundsComponent>(entity).bounds))
+            callback(entity);
+    });
+}
+
+entt::entity Scene::CastRay(const Ray& ray, float maxDistance, float* distance)
+{
+    entt::entity hit = entt::null;
+
+    // The tree only tests the fat boxes, every candidate clips the ray to its exact box
+    bvh.CastRay(ray, maxDistance, [&](entt::entity entity, float)
+    {
+        float boundsDistance;
+
+        if(ray.Intersects(registry.get<WorldBoundsComponent>(entity).bounds, maxDistance, boundsDistance))
+        {
+            hit = entity;
+            maxDistance = boundsDistance;
+        }
+
+        return maxDistance;
+    });
+
+    if(distance && hit != entt::null)
+        *distance = maxDistance;
+
+    return hit;
+}
+
+const DynamicBVH& Scene::GetBVH() const
+{
+    return bvh;
+}
+
+void Scene::SortHierarchy()
+{
+    LUSTRA_PROFILE_ZONE("Scene::SortHierarchy");
+
+    auto view = registry.view<TransformComponent, WorldTransformComponent>();
+
+    // An ancestor without a transform ends the chain, like a missing parent
+    for(auto entity : view)
+    {
+        uint32_t depth = 0;
+
+        auto current = entity;
+
+        while(auto hierarchy = registry.try_get<HierarchyComponent>(current))
+        {
+            current = hierarchy->parent;
+
+            if(!view.contains(current))
+                break;
+
+            depth++;
+        }
+
+        view.get<WorldTransformComponent>(entity).depth = depth;
+    }
+
+    hierarchyOrder.assign(view.begin(), view.end());
+
+    // Parents before children. Stable, so entities of the same depth keep the order of the last sort
+    std::stable_sort(hierarchyOrder.begin(), hierarchyOrder.end(), [&](auto lhs, auto rhs)
+    {
+        return view.get<WorldTransformComponent>(lhs).depth < view.get<WorldTransformComponent>(rhs).depth;
+    });
+
+    // Caches whose transform is gone go to the end
+    for(auto [entity, world] : registry.view<WorldTransformComponent>().each())
+        world.order = noHierarchyParent;
+
+    for(size_t i = 0; i < hierarchyOrder.size(); i++)
+        view.get<WorldTransformComponent>(hierarchyOrder[i]).order = i;
+
+    // Only the cache follows the order, scripts and the editor hold references into TransformComponent
+    registry.sort<WorldTransformComponent>(
+        [](const WorldTransformComponent& lhs, const WorldTransformComponent& rhs)
+        {
+            return lhs.order < rhs.order;
+        }
+    );
+
+    hierarchyParents.clear();
+
+    for(auto entity : hierarchyOrder)
+    {
+        auto hierarchy = registry.try_get<HierarchyComponent>(entity);
+
+        hierarchyParents.push_back(
+            hierarchy && view.contains(hierarchy->parent)
+                ? view.get<WorldTransformComponent>(hierarchy->parent).order
+                : noHierarchyParent
+        );
+    }
+
+    hierarchyChanged = false;
+}
+
+void Scene::OnWorldTransformChanged(entt::registry& registry, entt::entity entity)
+{
+    hierarchyChanged = true;
+
+    // A transform added back later starts at the same version again
+    if(auto world = registry.try_get<WorldTransformComponent>(entity))
+        world->dirty = true;
+}
+
+void Scene::OnNameChanged(entt::registry& registry, entt::entity entity)
+{
+    OnNameRemoved(registry, entity);
+
+    auto& name = registry.get<NameComponent>(entity).name;
+
+    nameIndex[name].push_back(entity);
+    indexedNames[entity] = name;
+}
+
+void Scene::OnNameRemoved(entt::registry& registry, entt::entity entity)
+{
+    auto indexed = indexedNames.find(entity);
+
+    if(indexed == indexedNames.end())
+        return;
+
+    auto it = nameIndex.find(indexed->second);
+
+    if(it != nameIndex.end())
+    {
+        auto& entities = it->second;
+
+        entities.erase(std::find(entities.begin(), entities.end(), entity));
+
+        if(entities.empty())
+            nameIndex.erase(it);
+    }
+
+    indexedNames.erase(indexed);
+}
+
+void Scene::OnBoundsCreated(entt::registry& registry, entt::entity entity)
+{
+    // A cloned component still holds the original's leaf
+    registry.get<WorldBoundsComponent>(entity).proxy = DynamicBVH::nullNode;
+}
+
+void Scene::OnBoundsRemoved(entt::registry& registry, entt::entity entity)
+{
+    auto& bounds = registry.get<WorldBoundsComponent>(entity);
+
+    if(bounds.proxy != DynamicBVH::nullNode)
+        bvh.Remove(bounds.proxy);
+}
+
+MemoryUsage Scene::GetShadowMapsMemoryUsage()
+{
+    MemoryUsage usage;
+
+    registry.view<LightComponent>().each([&](auto entity, auto& light)
+    {
+        usage.gpuBytes += Renderer::Get().GetResourceSize(light.depth);
+    });
+
+    return usage;
+}
+
+MemoryUsage Scene::GetEnvironmentsMemoryUsage()
+{
+    MemoryUsage usage;
+
+    registry.view<HDRISkyComponent>().each([&](auto entity, auto& sky)
+    {
+        if(sky.asset)
+            usage += sky.asset->GetMemoryUsage();
+    });
+
+    registry.view<ProceduralSkyComponent>().each([&](auto entity, auto& sky)
+    {
+        if(sky.asset)
+            usage += sky.asset->GetMemoryUsage();
+    });
+
+    return usage;
+}
+
 entt::registry& Scene::GetRegistry()
 {
     return registry;
 }
 
+SystemScheduler& Scene::GetSystems()
+{
+    return updateSystems;
+}
+
+EntityCommandBuffer& Scene::GetCommands()
+{
+    return commands;
+}
+
 void Scene::SetupLightsBuffer()
 {
     static const uint64_t maxLights = 128;
@@ -359,6 +853,8 @@ void Scene::UpdateLightsBuffer()
         [&](auto commandBuffer)
         {
             commandBuffer->UpdateBuffer(*lightsBuffer, 0, lights.data(), lights.size() * sizeof(Light));
+
+            Renderer::Get().CountBufferUpdate(lights.size() * sizeof(Light));
         }, {}, [](auto) {}, nullptr
     );
 }
@@ -369,6 +865,8 @@ void Scene::UpdateShadowsBuffer()
         [&](auto commandBuffer)
         {
             commandBuffer->UpdateBuffer(*shadowsBuffer, 0, shadows.data(), shadows.size() * sizeof(Shadow));
+
+            Renderer::Get().CountBufferUpdate(shadows.size() * sizeof(Shadow));
         }, {}, [](auto) {}, nullptr
     );
 }
@@ -390,16 +888,16 @@ void Scene::SetupCamera()
             camera = &cam.camera;
             cameraTransform = transform;
         
-            if(registry.all_of<HierarchyComponent>(entity))
+            if(registry.all_of<HierarchyComponent, WorldTransformComponent>(entity))
             {
-                auto rotation = cameraTransform.rotation;
+                auto rotation = cameraTransform.GetRotation();
 
-                cameraTransform.SetTransform(GetWorldTransform(entity));
+                cameraTransform.SetTransform(registry.get<WorldTransformComponent>(entity).transform);
 
-                cameraTransform.rotation = rotation;
+                cameraTransform.SetRotation(rotation);
             }
 
-            cameraPosition = cameraTransform.position;
+            cameraPosition = cameraTransform.GetPosition();
         }
     }
 
@@ -409,12 +907,12 @@ void Scene::SetupCamera()
 
         if(camera->IsFirstPerson())
         {
-            auto delta = glm::quat(glm::radians(cameraTransform.rotation)) * glm::vec3(0.0f, 0.0f, -1.0f);
+            auto delta = cameraTransform.GetRotation() * glm::vec3(0.0f, 0.0f, -1.0f);
 
-            view = glm::lookAt(cameraTransform.position, cameraTransform.position + delta, camera->GetUp());
+            view = glm::lookAt(cameraTransform.GetPosition(), cameraTransform.GetPosition() + delta, camera->GetUp());
         }
         else
-            view = glm::lookAt(cameraTransform.position, camera->GetLookAt(), camera->GetUp());
+            view = glm::lookAt(cameraTransform.GetPosition(), camera->GetLookAt(), camera->GetUp());
 
         camera->SetViewMatrix(view);
         
@@ -425,31 +923,38 @@ void Scene::SetupCamera()
 
 void Scene::SetupLights()
 {
-    lights.clear();
+    LUSTRA_PROFILE_ZONE("Scene::SetupLights");
 
     auto lightsView = registry.view<LightComponent, TransformComponent>();
 
-    for(auto entity : lightsView)
+    FrameVector<entt::entity> entities(lightsView.begin(), lightsView.end(), FrameArena::Get().GetResource());
+
+    // Written by index to keep the buffer order stable
+    lights.resize(entities.size());
+
+    Multithreading::Get().ParallelFor(entities.size(), [&](size_t begin, size_t end)
     {
-        auto [light, transform] = lightsView.get<LightComponent, TransformComponent>(entity);
+        for(size_t i = begin; i < end; i++)
+        {
+            auto [light, transform] = lightsView.get<LightComponent, TransformComponent>(entities[i]);
 
-        // Not a reference since we don't want to change the actual local transform...
-        auto localTransform = transform;
+            // Not a reference since we don't want to change the actual local transform...
+            auto localTransform = transform;
 
-        if(registry.all_of<HierarchyComponent>(entity))
-            localTransform.SetTransform(GetWorldTransform(entity));
+            if(registry.all_of<HierarchyComponent, WorldTransformComponent>(entities[i]))
+                localTransform.SetTransform(registry.get<WorldTransformComponent>(entities[i]).transform);
 
-        lights.push_back(
+            lights[i] =
             {
-                localTransform.position,
-                glm::quat(glm::radians(localTransform.rotation)) * glm::vec3(0.0f, 0.0f, -1.0f),
+                localTransform.GetPosition(),
+                localTransform.GetRotation() * glm::vec3(0.0f, 0.0f, -1.0f),
                 light.color,
                 light.intensity,
                 glm::cos(glm::radians(light.cutoff)),
                 glm::cos(glm::radians(light.outerCutoff))
-            }
-        );
-    }
+            };
+        }
+    }, 16);
 }
 
 void Scene::SetupShadows()
@@ -472,85 +977,246 @@ void Scene::SetupShadows()
 
         if(light.shadowMap)
         {
-            auto localTransform = transform;
-
-            if(registry.all_of<HierarchyComponent>(entity))
-                localTransform.SetTransform(GetWorldTransform(entity));
-
-            auto delta = glm::quat(glm::radians(localTransform.rotation)) * glm::vec3(0.0f, 0.0f, -1.0f);
-        
-            shadows.push_back(
-                {
-                    light.projection *
-                    glm::lookAt(localTransform.position, localTransform.position + delta, glm::vec3(0.0f, 1.0f, 0.0f)),
-                    light.bias
-                }
-            );
+            shadows.push_back({ light.projection * GetLightView(entity, transform), light.bias });
 
             shadowSamplers[shadows.size() - 1] = light.depth;
         }
     }
 }
 
-void Scene::RenderMeshes()
+glm::mat4 Scene::GetLightView(entt::entity light, const TransformComponent& transform)
 {
-    auto view = registry.view<TransformComponent, MeshComponent, MeshRendererComponent, PipelineComponent>();
-    
-    for(auto entity : view)
+    // Not a reference since we don't want to change the actual local transform...
+    auto worldTransform = transform;
+
+    if(registry.all_of<HierarchyComponent, WorldTransformComponent>(light))
+        worldTransform.SetTransform(registry.get<WorldTransformComponent>(light).transform);
+
+    auto delta = worldTransform.GetRotation() * glm::vec3(0.0f, 0.0f, -1.0f);
+
+    return glm::lookAt(worldTransform.GetPosition(), worldTransform.GetPosition() + delta, glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+void Scene::PushPhysicsTransforms()
+{
+    LUSTRA_PROFILE_ZONE("Scene::PushPhysicsTransforms");
+
+    auto view = registry.view<TransformComponent, RigidBodyComponent>();
+
+    Multithreading::Get().ParallelEach(view, [&](auto entity, auto& transform, auto& rigidBody)
     {
-        auto [transform, mesh, meshRenderer, pipeline] = 
-                view.get<TransformComponent, MeshComponent, MeshRendererComponent, PipelineComponent>(entity);
+        if(!transform.overridePhysics || !rigidBody.body)
+            return;
+
+        auto body = rigidBody.body;
+        auto bodyId = body->GetID();
+
+        auto& position = transform.GetPosition();
+        auto& rotation = transform.GetRotation();
 
-        if(registry.all_of<RigidBodyComponent>(entity))
+        PhysicsManager::Get().GetBodyInterface().SetPositionAndRotation(
+            bodyId,
+            { position.x, position.y, position.z },
+            { rotation.x, rotation.y, rotation.z, rotation.w },
+            JPH::EActivation::Activate
+        );
+
+        body->SetLinearVelocity({ 0.0f, 0.0f, 0.0f });
+        body->SetAngularVelocity({ 0.0f, 0.0f, 0.0f });
+    });
+}
+
+void Scene::SyncPhysicsTransforms()
+{
+    LUSTRA_PROFILE_ZONE("Scene::SyncPhysicsTransforms");
+
+    static constexpr size_t grainSize = 256;
+
+    auto& physicsSystem = PhysicsManager::Get().GetPhysicsSystem();
+
+    // Bodies find their entity through their user data
+    if(rigidBodiesChanged)
+    {
+        registry.view<RigidBodyComponent>().each([&](auto entity, auto& rigidBody)
         {
-            auto body = registry.get<RigidBodyComponent>(entity).body;
+            if(rigidBody.body)
+                rigidBody.body->SetUserData((uint64_t)entity);
+        });
 
-            if(transform.overridePhysics)
-            {
-                auto bodyId = body->GetID();
+        rigidBodiesChanged = false;
+    }
 
-                auto position = transform.position;
-                auto rotation = glm::quat(glm::radians(transform.rotation));
+    // Sleeping bodies haven't moved, so only the active ones are copied
+    physicsSystem.GetActiveBodies(JPH::EBodyType::RigidBody, activeBodies);
 
-                PhysicsManager::Get().GetBodyInterface().SetPositionAndRotation(
-                    bodyId,
-                    { position.x, position.y, position.z },
-                    { rotation.x, rotation.y, rotation.z, rotation.w },
-                    JPH::EActivation::Activate
-                );
+    // Plus the ones that fell asleep during the step, their resting pose wasn't copied yet.
+    // Skipping those awake again and the repeats keeps every body in one chunk only
+    auto activeNum = activeBodies.size();
 
-                body->SetLinearVelocity({ 0.0f, 0.0f, 0.0f });
-                body->SetAngularVelocity({ 0.0f, 0.0f, 0.0f });
-            }
-            else
+    PhysicsManager::Get().TakeDeactivatedBodies(activeBodies);
+
+    auto& bodyInterface = physicsSystem.GetBodyInterfaceNoLock();
+
+    auto deactivatedEnd = std::remove_if(activeBodies.begin() + activeNum, activeBodies.end(), [&](const auto& bodyId)
+    {
+        return bodyInterface.IsActive(bodyId);
+    });
+
+    std::sort(activeBodies.begin() + activeNum, deactivatedEnd);
+
+    activeBodies.erase(std::unique(activeBodies.begin() + activeNum, deactivatedEnd), activeBodies.end());
+
+    // Looked up here, the workers only read them
+    auto& rigidBodies = registry.storage<RigidBodyComponent>();
+    auto& transforms = registry.storage<TransformComponent>();
+
+    std::atomic<bool> unmappedBodies = false;
+
+    Multithreading::Get().ParallelFor(
+        activeBodies.size(),
+        [&](size_t begin, size_t end)
+        {
+            // One lock for the whole chunk instead of one per body
+            JPH::BodyLockMultiRead lock(physicsSystem.GetBodyLockInterface(), activeBodies.data() + begin, int(end - begin));
+
+            for(size_t i = begin; i < end; i++)
             {
+                auto body = lock.GetBody(int(i - begin));
+
+                if(!body)
+                    continue;
+
+                auto entity = entt::entity(body->GetUserData());
+
+                // A body given to a component without a patch isn't mapped yet
+                if(!rigidBodies.contains(entity) || rigidBodies.get(entity).body != body)
+                {
+                    unmappedBodies = true;
+                    continue;
+                }
+
+                if(!transforms.contains(entity))
+                    continue;
+
+                auto& transform = transforms.get(entity);
+
+                if(transform.overridePhysics)
+                    continue;
+
                 auto position = body->GetPosition();
-                auto rotation = body->GetRotation().GetEulerAngles();
+                auto rotation = body->GetRotation();
 
-                transform.position = { position.GetX(), position.GetY(), position.GetZ() };
-                transform.rotation = glm::degrees(glm::vec3(rotation.GetX(), rotation.GetY(), rotation.GetZ()));
+                transform.SetPosition({ position.GetX(), position.GetY(), position.GetZ() });
+                transform.SetRotation(glm::quat(rotation.GetW(), rotation.GetX(), rotation.GetY(), rotation.GetZ()));
             }
+        },
+        grainSize
+    );
+
+    if(unmappedBodies)
+        rigidBodiesChanged = true;
+}
+
+void Scene::OnRigidBodyChanged(entt::registry& registry, entt::entity entity)
+{
+    rigidBodiesChanged = true;
+}
+
+Scene::DrawList::DrawList(std::pmr::memory_resource* resource)
+    : entities(resource), meshes(resource), bounds(resource)
+{
+}
+
+void Scene::GatherDrawList(DrawList& drawList)
+{
+    LUSTRA_PROFILE_ZONE("Scene::GatherDrawList");
+
+    auto view = registry.view<WorldBoundsComponent, MeshComponent, MeshRendererComponent, PipelineComponent>();
+
+    for(auto entity : view)
+    {
+        auto& bounds = view.get<WorldBoundsComponent>(entity);
+
+        for(size_t i = 0; i < bounds.meshBounds.size(); i++)
+        {
+            // A mesh without vertices has nothing to draw, and the culling can't handle its box
+            if(bounds.meshBounds[i].IsEmpty())
+                continue;
+
+            drawList.bounds.Add(bounds.meshBounds[i]);
+
+            drawList.entities.push_back(entity);
+            drawList.meshes.push_back(i);
         }
+    }
+}
+
+size_t Scene::CullDrawList(const DrawList& drawList, const Frustum& frustum, FrameVector<uint8_t>& visible)
+{
+    LUSTRA_PROFILE_ZONE("Scene::CullDrawList");
+
+    static constexpr size_t grainSize = 4096;
+
+    visible.resize(drawList.bounds.GetSize());
+
+    std::atomic<size_t> visibleNum = 0;
+
+    Multithreading::Get().ParallelFor(
+        drawList.bounds.GetSize(),
+        [&](size_t begin, size_t end)
+        {
+            visibleNum += CullingKernel::Get().Cull(frustum, drawList.bounds, begin, end, visible.data());
+        },
+        grainSize
+    );
+
+    return visibleNum;
+}
+
+void Scene::RenderMeshes(const DrawList& drawList)
+{
+    LUSTRA_PROFILE_ZONE("Scene::RenderMeshes");
+
+    // Against the matrices the meshes are drawn with
+    Frustum frustum(Renderer::Get().GetMatrices()->GetProjection() * Renderer::Get().GetMatrices()->GetView());
+
+    FrameVector<uint8_t> visible(FrameArena::Get().GetResource());
+
+    auto visibleNum = CullDrawList(drawList, frustum, visible);
+
+    Renderer::Get().CountCulling(renderer->GetPrimaryRenderTarget(), visibleNum, visible.size() - visibleNum);
+
+    for(size_t i = 0; i < drawList.entities.size(); i++)
+    {
+        if(!visible[i])
+            continue;
+
+        auto [world, mesh, meshRenderer, pipeline] =
+                registry.get<WorldTransformComponent, MeshComponent, MeshRendererComponent, PipelineComponent>(drawList.entities[i]);
 
         Renderer::Get().GetMatrices()->PushMatrix();
-        Renderer::Get().GetMatrices()->GetModel() = GetWorldTransform(entity);
+        Renderer::Get().GetMatrices()->GetModel() = world.transform;
 
-        MeshRenderPass(mesh, meshRenderer, pipeline, renderer->GetPrimaryRenderTarget());
+        MeshRenderPass(mesh, meshRenderer, pipeline, drawList.meshes[i], renderer->GetPrimaryRenderTarget());
 
         Renderer::Get().GetMatrices()->PopMatrix();
     }
 
-    if(view.begin() == view.end())
+    if(!visibleNum)
         Renderer::Get().ClearRenderTarget(renderer->GetPrimaryRenderTarget());
 }
 
-void Scene::RenderToShadowMap()
+void Scene::RenderToShadowMap(const DrawList& drawList)
 {
+    LUSTRA_PROFILE_ZONE("Scene::RenderToShadowMap");
+
     Renderer::Get().Begin();
 
-    auto meshesView = registry.view<TransformComponent, MeshComponent, MeshRendererComponent, PipelineComponent>();
     auto lightsView = registry.view<LightComponent, TransformComponent>();
 
+    // Reused by every light
+    FrameVector<uint8_t> visible(FrameArena::Get().GetResource());
+
     for(auto light : lightsView)
     {
         auto [lightComponent, lightTransform] = 
@@ -560,20 +1226,28 @@ void Scene::RenderToShadowMap()
         {
             Renderer::Get().ClearRenderTarget(lightComponent.renderTarget, false);
 
-            auto delta = glm::quat(glm::radians(lightTransform.rotation)) * glm::vec3(0.0f, 0.0f, -1.0f);
+            // The same matrix SetupShadows hands to the shading pass
+            auto view = GetLightView(light, lightTransform);
 
-            Renderer::Get().GetMatrices()->GetView() = glm::lookAt(lightTransform.position, lightTransform.position + delta, glm::vec3(0.0f, 1.0f, 0.0f));
+            Renderer::Get().GetMatrices()->GetView() = view;
             Renderer::Get().GetMatrices()->GetProjection() = lightComponent.projection;
 
-            for(auto mesh : meshesView)
+            // Casters outside the light's frustum would be clipped anyway, perspective or ortho
+            auto visibleNum = CullDrawList(drawList, Frustum(lightComponent.projection * view), visible);
+
+            Renderer::Get().CountCulling(lightComponent.renderTarget, visibleNum, visible.size() - visibleNum);
+
+            for(size_t i = 0; i < drawList.entities.size(); i++)
             {
-                auto [transform, meshComp, meshRenderer, pipeline] =
-                        meshesView.get<TransformComponent, MeshComponent, MeshRendererComponent, PipelineComponent>(mesh);
+                if(!visible[i])
+                    continue;
+
+                auto [world, mesh] = registry.get<WorldTransformComponent, MeshComponent>(drawList.entities[i]);
 
                 Renderer::Get().GetMatrices()->PushMatrix();
-                Renderer::Get().GetMatrices()->GetModel() = GetWorldTransform(mesh);
+                Renderer::Get().GetMatrices()->GetModel() = world.transform;
 
-                ShadowRenderPass(lightComponent, meshComp);
+                ShadowRenderPass(lightComponent, mesh, drawList.meshes[i]);
 
                 Renderer::Get().GetMatrices()->PopMatrix();
             }
@@ -613,64 +1287,67 @@ void Scene::MeshRenderPass(
     const MeshComponent& mesh,
     const MeshRendererComponent& meshRenderer,
     const PipelineComponent& pipeline,
+    size_t meshIndex,
     LLGL::RenderTarget* renderTarget
 )
 {
-    if(!mesh.model)
+    // The bounds lag a frame behind a model that just finished loading
+    if(!mesh.model || meshIndex >= mesh.model->meshes.size())
         return;
 
-    for(size_t i = 0; i < mesh.model->meshes.size(); i++)
-    {
-        auto material = AssetManager::Get().Load<MaterialAsset>("default", true);
+    auto& modelMesh = mesh.model->meshes[meshIndex];
 
-        if(meshRenderer.materials.size() > i)
-            material = meshRenderer.materials[i];
+    // Only looked up when needed, building the path allocates
+    auto material = meshRenderer.materials.size() > meshIndex
+        ? meshRenderer.materials[meshIndex]
+        : AssetManager::Get().Load<MaterialAsset>("default", true);
 
-        Renderer::Get().RenderPass(
-            [&](auto commandBuffer)
-            {
-                mesh.model->meshes[i]->BindBuffers(commandBuffer);
-            },
-            {
-                { 0, Renderer::Get().GetMatricesBuffer() },
-                { 1, material->albedo.texture->texture },
-                { 2, material->normal.texture->texture },
-                { 3, material->metallic.texture->texture },
-                { 4, material->roughness.texture->texture },
-                { 5, material->ao.texture->texture },
-                { 6, material->emission.texture->texture },
-                { 7, material->albedo.texture->sampler }
-            },
-            [&](auto commandBuffer)
-            {
-                material->SetUniforms(commandBuffer);
+    Renderer::Get().RenderPass(
+        [&](auto commandBuffer)
+        {
+            modelMesh->BindBuffers(commandBuffer);
+        },
+        {
+            { 0, Renderer::Get().GetMatricesBuffer() },
+            { 1, material->albedo.texture->texture },
+            { 2, material->normal.texture->texture },
+            { 3, material->metallic.texture->texture },
+            { 4, material->roughness.texture->texture },
+            { 5, material->ao.texture->texture },
+            { 6, material->emission.texture->texture },
+            { 7, material->albedo.texture->sampler }
+        },
+        [&](auto commandBuffer)
+        {
+            material->SetUniforms(commandBuffer);
 
-                mesh.model->meshes[i]->Draw(commandBuffer);
-            },
-            pipeline.pipeline,
-            renderer->GetPrimaryRenderTarget()
-        );
-    }
+            modelMesh->Draw(commandBuffer);
+        },
+        pipeline.pipeline,
+        renderer->GetPrimaryRenderTarget()
+    );
 }
 
-void Scene::ShadowRenderPass(const LightComponent& light, const MeshComponent& mesh)
+void Scene::ShadowRenderPass(const LightComponent& light, const MeshComponent& mesh, size_t meshIndex)
 {
-    for(size_t i = 0; i < mesh.model->meshes.size(); i++)
-    {
-        Renderer::Get().RenderPass(
-            [&](auto commandBuffer)
-            {
-                mesh.model->meshes[i]->BindBuffers(commandBuffer);
-            },
-            { { 0, Renderer::Get().GetMatricesBuffer() } },
-            [&](auto commandBuffer)
-            {
-                mesh.model->meshes[i]->Draw(commandBuffer);
-            },
-            light.shadowMapPipeline,
-            light.renderTarget
-        );
-    }
+    if(!mesh.model || meshIndex >= mesh.model->meshes.size())
+        return;
+
+    auto& modelMesh = mesh.model->meshes[meshIndex];
+
+    Renderer::Get().RenderPass(
+        [&](auto commandBuffer)
+        {
+            modelMesh->BindBuffers(commandBuffer);
+        },
+        { { 0, Renderer::Get().GetMatricesBuffer() } },
+        [&](auto commandBuffer)
+        {
+            modelMesh->Draw(commandBuffer);
+        },
+        light.shadowMapPipeline,
+        light.renderTarget
+    );
 }
 
 void Scene::ProceduralSkyRenderPass(
@@ -793,6 +1470,8 @@ void Scene::RenderResult(LLGL::RenderTarget* renderTarget)
 
 void Scene::ApplyPostProcessing(LLGL::RenderTarget* renderTarget)
 {
+    LUSTRA_PROFILE_ZONE("Scene::ApplyPostProcessing");
+
     auto tonemapView = registry.view<TonemapComponent>();
     
     if(tonemapView->begin() == tonemapView->end())
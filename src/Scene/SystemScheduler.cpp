@@ -0,0 +1,247 @@
+#include <SystemScheduler.hpp>
+#include <Multithreading.hpp>
+#include <Profiler.hpp>
+
+#include <LLGL/Log.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace lustra
+{
+
+System::System(const char* name, Function function)
+    : name(name), function(std::move(function))
+{
+}
+
+System& System::Exclusive()
+{
+    exclusive = true;
+
+    return *this;
+}
+
+System& System::OnMainThread()
+{
+    mainThread = true;
+
+    return *this;
+}
+
+bool System::ConflictsWith(const System& other) const
+{
+    if(exclusive || other.exclusive)
+        return true;
+
+    auto contains = [](const std::vector<entt::id_type>& types, entt::id_type type)
+    {
+        return std::find(types.begin(), types.end(), type) != types.end();
+    };
+
+    for(auto type : writes)
+        if(contains(other.reads, type) || contains(other.writes, type))
+            return true;
+
+    for(auto type : other.writes)
+        if(contains(reads, type))
+            return true;
+
+    return false;
+}
+
+const char* System::GetName() const
+{
+    return name;
+}
+
+struct SystemScheduler::State
+{
+    // Never changes, helpers that find nothing to run don't touch the scheduler
+    SystemScheduler* scheduler;
+
+    float deltaTime = 0.0f;
+
+    // Rebuilt by every Update, kept for their capacity
+    std::vector<std::vector<uint32_t>> successors;
+    std::vector<std::atomic<uint32_t>> remainingDependencies;
+
+    std::atomic<size_t> finishedNum = 0;
+
+    std::mutex readyMutex;
+
+    // Taken by the pool's helpers and by the thread calling Update
+    std::vector<uint32_t> readyWorkers;
+
+    // Only the thread calling Update takes these
+    std::vector<uint32_t> readyMain;
+};
+
+SystemScheduler::SystemScheduler(bool useJobPool)
+    : useJobPool(useJobPool), state(std::make_shared<State>())
+{
+    state->scheduler = this;
+}
+
+SystemScheduler::~SystemScheduler() = default;
+
+System& SystemScheduler::AddSystem(const char* name, System::Function function)
+{
+    return *systems.emplace_back(std::make_unique<System>(name, std::move(function)));
+}
+
+void SystemScheduler::RemoveSystem(std::string_view name)
+{
+    std::erase_if(systems, [&](const auto& system) { return system->name == name; });
+}
+
+void SystemScheduler::Clear()
+{
+    systems.clear();
+}
+
+void SystemScheduler::Update(float deltaTime)
+{
+    LUSTRA_PROFILE_ZONE("SystemScheduler::Update");
+
+    auto systemsNum = systems.size();
+
+    if(!systemsNum)
+        return;
+
+    state->deltaTime = deltaTime;
+    state->finishedNum = 0;
+
+    // Built every frame, so the access declared after AddSystem is always seen.
+    // Every system waits for the earlier ones it conflicts with
+    state->successors.resize(systemsNum);
+
+    for(auto& successors : state->successors)
+        successors.clear();
+
+    if(state->remainingDependencies.size() != systemsNum)
+        state->remainingDependencies = std::vector<std::atomic<uint32_t>>(systemsNum);
+
+    for(uint32_t i = 0; i < systemsNum; i++)
+    {
+        state->remainingDependencies[i] = 0;
+
+        for(uint32_t j = 0; j < i; j++)
+        {
+            if(systems[j]->ConflictsWith(*systems[i]))
+            {
+                state->successors[j].push_back(i);
+                state->remainingDependencies[i]++;
+            }
+        }
+    }
+
+    FrameVector<uint32_t> roots(FrameArena::Get().GetResource());
+
+    for(uint32_t i = 0; i < systemsNum; i++)
+        if(state->remainingDependencies[i] == 0)
+            roots.push_back(i);
+
+    for(auto root : roots)
+        Dispatch(root);
+
+    // The calling thread runs its own systems and helps with the others
+    uint32_t index;
+
+    while(state->finishedNum < systemsNum)
+    {
+        if(PopReadyMain(index))
+            Run(index);
+        else if(!RunReadyWorker(*state))
+            std::this_thread::yield();
+    }
+}
+
+void SystemScheduler::Dispatch(uint32_t index)
+{
+    if(systems[index]->mainThread || !useJobPool)
+    {
+        std::lock_guard lock(state->readyMutex);
+
+        state->readyMain.push_back(index);
+
+        return;
+    }
+
+    {
+        std::lock_guard lock(state->readyMutex);
+
+        state->readyWorkers.push_back(index);
+    }
+
+    // Whichever thread gets there first runs it, a helper that finds nothing just returns
+    Multithreading::Get().Schedule([state = state]() { while(RunReadyWorker(*state)); });
+}
+
+void SystemScheduler::Run(uint32_t index)
+{
+    auto& system = *systems[index];
+
+    {
+        LUSTRA_PROFILE_ZONE(system.name);
+
+        // A failed system still releases the ones waiting for it
+        try
+        {
+            system.function(state->deltaTime);
+        }
+        catch(const std::exception& exception)
+        {
+            LLGL::Log::Errorf(
+                LLGL::Log::ColorFlags::StdError,
+                "System \"%s\" failed: %s\n", system.name, exception.what()
+            );
+        }
+    }
+
+    for(auto successor : state->successors[index])
+        if(--state->remainingDependencies[successor] == 0)
+            Dispatch(successor);
+
+    // Last, Update may return as soon as every system is counted
+    state->finishedNum++;
+}
+
+bool SystemScheduler::PopReadyMain(uint32_t& index)
+{
+    std::lock_guard lock(state->readyMutex);
+
+    if(state->readyMain.empty())
+        return false;
+
+    index = state->readyMain.back();
+    state->readyMain.pop_back();
+
+    return true;
+}
+
+bool SystemScheduler::RunReadyWorker(State& state)
+{
+    uint32_t index;
+
+    {
+        std::lock_guard lock(state.readyMutex);
+
+        if(state.readyWorkers.empty())
+            return false;
+
+        index = state.readyWorkers.back();
+        state.readyWorkers.pop_back();
+    }
+
+    state.scheduler->Run(index);
+
+    return true;
+}
+
+size_t SystemScheduler::GetSystemsNum() const
+{
+    return systems.size();
+}
+
+}
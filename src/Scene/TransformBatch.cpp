@@ -0,0 +1,392 @@
+#include <TransformBatch.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define LUSTRA_TRANSFORM_SIMD
+
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+
+        // MSVC emits AVX2 intrinsics without a target switch
+        #define LUSTRA_TARGET_AVX2
+    #else
+        #define LUSTRA_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#endif
+
+namespace lustra
+{
+
+TransformBatch::TransformBatch(std::pmr::memory_resource* resource)
+    : positionX(resource), positionY(resource), positionZ(resource),
+      rotationX(resource), rotationY(resource), rotationZ(resource), rotationW(resource),
+      scaleX(resource), scaleY(resource), scaleZ(resource),
+      parents(resource), outputs(resource)
+{
+}
+
+void TransformBatch::Add(const TransformComponent& transform, const glm::mat4* parent, glm::mat4* output)
+{
+    auto& position = transform.GetPosition();
+    auto& rotation = transform.GetRotation();
+    auto& scale = transform.GetScale();
+
+    positionX.push_back(position.x);
+    positionY.push_back(position.y);
+    positionZ.push_back(position.z);
+
+    rotationX.push_back(rotation.x);
+    rotationY.push_back(rotation.y);
+    rotationZ.push_back(rotation.z);
+    rotationW.push_back(rotation.w);
+
+    scaleX.push_back(scale.x);
+    scaleY.push_back(scale.y);
+    scaleZ.push_back(scale.z);
+
+    parents.push_back(parent);
+    outputs.push_back(output);
+}
+
+void TransformBatch::Reserve(size_t size)
+{
+    for(auto array : { &positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &rotationW, &scaleX, &scaleY, &scaleZ })
+        array->reserve(size);
+
+    parents.reserve(size);
+    outputs.reserve(size);
+}
+
+void TransformBatch::Clear()
+{
+    for(auto array : { &positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &rotationW, &scaleX, &scaleY, &scaleZ })
+        array->clear();
+
+    parents.clear();
+    outputs.clear();
+}
+
+size_t TransformBatch::GetSize() const
+{
+    return outputs.size();
+}
+
+namespace
+{
+
+// Entries are written in order, so a parent earlier in the batch is already composed
+void ComposeScalar(const TransformBatch& batch, size_t begin, size_t end)
+{
+    for(size_t i = begin; i < end; i++)
+    {
+        float x = batch.rotationX[i], y = batch.rotationY[i], z = batch.rotationZ[i], w = batch.rotationW[i];
+
+        float xx = x * x, yy = y * y, zz = z * z;
+        float xy = x * y, xz = x * z, yz = y * z;
+        float wx = w * x, wy = w * y, wz = w * z;
+
+        float sx = batch.scaleX[i], sy = batch.scaleY[i], sz = batch.scaleZ[i];
+
+        // Same terms as glm::mat3_cast, scaled per column
+        glm::mat4 local(
+            (1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx, 2.0f * (xz - wy) * sx, 0.0f,
+            2.0f * (xy - wz) * sy, (1.0f - 2.0f * (xx + zz)) * sy, 2.0f * (yz + wx) * sy, 0.0f,
+            2.0f * (xz + wy) * sz, 2.0f * (yz - wx) * sz, (1.0f - 2.0f * (xx + yy)) * sz, 0.0f,
+            batch.positionX[i], batch.positionY[i], batch.positionZ[i], 1.0f
+        );
+
+        *batch.outputs[i] = batch.parents[i] ? *batch.parents[i] * local : local;
+    }
+}
+
+#ifdef LUSTRA_TRANSFORM_SIMD
+
+// Columns of one local matrix, multiplied by the parent if there is one
+inline void StoreMatrix(const glm::mat4* parent, __m128 c0, __m128 c1, __m128 c2, __m128 c3, glm::mat4* output)
+{
+    if(parent)
+    {
+        __m128 p0 = _mm_loadu_ps(&(*parent)[0][0]);
+        __m128 p1 = _mm_loadu_ps(&(*parent)[1][0]);
+        __m128 p2 = _mm_loadu_ps(&(*parent)[2][0]);
+        __m128 p3 = _mm_loadu_ps(&(*parent)[3][0]);
+
+        auto multiply = [&](__m128 column)
+        {
+            return _mm_add_ps(
+                _mm_add_ps(
+                    _mm_mul_ps(p0, _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0))),
+                    _mm_mul_ps(p1, _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1)))
+                ),
+                _mm_add_ps(
+                    _mm_mul_ps(p2, _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))),
+                    _mm_mul_ps(p3, _mm_shuffle_ps(column, column, _MM_SHUFFLE(3, 3, 3, 3)))
+                )
+            );
+        };
+
+        c0 = multiply(c0);
+        c1 = multiply(c1);
+        c2 = multiply(c2);
+        c3 = multiply(c3);
+    }
+
+    _mm_storeu_ps(&(*output)[0][0], c0);
+    _mm_storeu_ps(&(*output)[1][0], c1);
+    _mm_storeu_ps(&(*output)[2][0], c2);
+    _mm_storeu_ps(&(*output)[3][0], c3);
+}
+
+// Four lanes of matrix elements to four matrices, the transposes turn lanes into columns
+inline void StoreMatrices(
+    const TransformBatch& batch,
+    size_t first,
+    const __m128 (&elements)[4][4]
+)
+{
+    __m128 columns[4][4];
+
+    for(int column = 0; column < 4; column++)
+    {
+        __m128 e0 = elements[column][0], e1 = elements[column][1], e2 = elements[column][2], e3 = elements[column][3];
+
+        _MM_TRANSPOSE4_PS(e0, e1, e2, e3);
+
+        columns[0][column] = e0;
+        columns[1][column] = e1;
+        columns[2][column] = e2;
+        columns[3][column] = e3;
+    }
+
+    for(int lane = 0; lane < 4; lane++)
+    {
+        StoreMatrix(
+            batch.parents[first + lane],
+            columns[lane][0], columns[lane][1], columns[lane][2], columns[lane][3],
+            batch.outputs[first + lane]
+        );
+    }
+}
+
+void ComposeSSE(const TransformBatch& batch, size_t begin, size_t end)
+{
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f);
+
+    size_t i = begin;
+
+    for(; i + 4 <= end; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(&batch.rotationX[i]);
+        __m128 y = _mm_loadu_ps(&batch.rotationY[i]);
+        __m128 z = _mm_loadu_ps(&batch.rotationZ[i]);
+        __m128 w = _mm_loadu_ps(&batch.rotationW[i]);
+
+        __m128 sx = _mm_loadu_ps(&batch.scaleX[i]);
+        __m128 sy = _mm_loadu_ps(&batch.scaleY[i]);
+        __m128 sz = _mm_loadu_ps(&batch.scaleZ[i]);
+
+        __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+        __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+        __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+        // elements[column][row], one entity per lane
+        const __m128 elements[4][4] =
+        {
+            {
+                _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+                _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+                _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+                zero
+            },
+            {
+                _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+                _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+                _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+                zero
+            },
+            {
+                _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+                _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+                _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+                zero
+            },
+            {
+                _mm_loadu_ps(&batch.positionX[i]),
+                _mm_loadu_ps(&batch.positionY[i]),
+                _mm_loadu_ps(&batch.positionZ[i]),
+                one
+            }
+        };
+
+        StoreMatrices(batch, i, elements);
+    }
+
+    ComposeScalar(batch, i, end);
+}
+
+LUSTRA_TARGET_AVX2 void ComposeAVX2(const TransformBatch& batch, size_t begin, size_t end)
+{
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f), two = _mm256_set1_ps(2.0f);
+
+    size_t i = begin;
+
+    for(; i + 8 <= end; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(&batch.rotationX[i]);
+        __m256 y = _mm256_loadu_ps(&batch.rotationY[i]);
+        __m256 z = _mm256_loadu_ps(&batch.rotationZ[i]);
+        __m256 w = _mm256_loadu_ps(&batch.rotationW[i]);
+
+        __m256 sx = _mm256_loadu_ps(&batch.scaleX[i]);
+        __m256 sy = _mm256_loadu_ps(&batch.scaleY[i]);
+        __m256 sz = _mm256_loadu_ps(&batch.scaleZ[i]);
+
+        __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+
+        // The products of different components are only ever needed summed or subtracted
+        __m256 xyPlusWz = _mm256_fmadd_ps(x, y, _mm256_mul_ps(w, z));
+        __m256 xyMinusWz = _mm256_fmsub_ps(x, y, _mm256_mul_ps(w, z));
+        __m256 xzPlusWy = _mm256_fmadd_ps(x, z, _mm256_mul_ps(w, y));
+        __m256 xzMinusWy = _mm256_fmsub_ps(x, z, _mm256_mul_ps(w, y));
+        __m256 yzPlusWx = _mm256_fmadd_ps(y, z, _mm256_mul_ps(w, x));
+        __m256 yzMinusWx = _mm256_fmsub_ps(y, z, _mm256_mul_ps(w, x));
+
+        const __m256 elements[4][4] =
+        {
+            {
+                _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(yy, zz), one), sx),
+                _mm256_mul_ps(_mm256_mul_ps(two, xyPlusWz), sx),
+                _mm256_mul_ps(_mm256_mul_ps(two, xzMinusWy), sx),
+                zero
+            },
+            {
+                _mm256_mul_ps(_mm256_mul_ps(two, xyMinusWz), sy),
+                _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(xx, zz), one), sy),
+                _mm256_mul_ps(_mm256_mul_ps(two, yzPlusWx), sy),
+                zero
+            },
+            {
+                _mm256_mul_ps(_mm256_mul_ps(two, xzPlusWy), sz),
+                _mm256_mul_ps(_mm256_mul_ps(two, yzMinusWx), sz),
+                _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(xx, yy), one), sz),
+                zero
+            },
+            {
+                _mm256_loadu_ps(&batch.positionX[i]),
+                _mm256_loadu_ps(&batch.positionY[i]),
+                _mm256_loadu_ps(&batch.positionZ[i]),
+                one
+            }
+        };
+
+        // The transposes and the parent products work on four entities at a time
+        for(int half = 0; half < 2; half++)
+        {
+            __m128 quarter[4][4];
+
+            for(int column = 0; column < 4; column++)
+                for(int row = 0; row < 4; row++)
+                    quarter[column][row] = half == 0
+                        ? _mm256_castps256_ps128(elements[column][row])
+                        : _mm256_extractf128_ps(elements[column][row], 1);
+
+            StoreMatrices(batch, i + half * 4, quarter);
+        }
+    }
+
+    ComposeSSE(batch, i, end);
+}
+
+bool IsAVX2Supported()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+
+    __cpuid(info, 0);
+
+    if(info[0] < 7)
+        return false;
+
+    __cpuid(info, 1);
+
+    bool fma = info[2] & (1 << 12);
+    bool osxsave = info[2] & (1 << 27);
+    bool avx = info[2] & (1 << 28);
+
+    // The OS has to save the YMM registers on context switches too
+    if(!fma || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+
+    return info[1] & (1 << 5);
+#else
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+#endif
+
+}
+
+TransformKernel::TransformKernel()
+{
+#ifdef LUSTRA_TRANSFORM_SIMD
+    // SSE2 is part of x86-64
+    bestInstructionSet = IsAVX2Supported() ? InstructionSet::AVX2 : InstructionSet::SSE;
+#endif
+
+    SetInstructionSet(bestInstructionSet);
+}
+
+void TransformKernel::Compose(const TransformBatch& batch, size_t begin, size_t end) const
+{
+    compose(batch, begin, end);
+}
+
+void TransformKernel::Compose(const TransformBatch& batch) const
+{
+    compose(batch, 0, batch.GetSize());
+}
+
+void TransformKernel::SetInstructionSet(InstructionSet instructionSet)
+{
+    if(!IsSupported(instructionSet))
+        instructionSet = bestInstructionSet;
+
+    this->instructionSet = instructionSet;
+
+    switch(instructionSet)
+    {
+#ifdef LUSTRA_TRANSFORM_SIMD
+    case InstructionSet::AVX2: compose = ComposeAVX2; break;
+    case InstructionSet::SSE: compose = ComposeSSE; break;
+#endif
+    default: compose = ComposeScalar; break;
+    }
+}
+
+TransformKernel::InstructionSet TransformKernel::GetInstructionSet() const
+{
+    return instructionSet;
+}
+
+bool TransformKernel::IsSupported(InstructionSet instructionSet) const
+{
+    return instructionSet <= bestInstructionSet;
+}
+
+std::string_view TransformKernel::GetName(InstructionSet instructionSet)
+{
+    switch(instructionSet)
+    {
+    case InstructionSet::SSE: return "SSE";
+    case InstructionSet::AVX2: return "AVX2";
+    default: return "Scalar";
+    }
+}
+
+}
@@ -1,5 +1,6 @@
 #include <ScriptManager.hpp>
 #include <Timer.hpp>
+#include <Profiler.hpp>
 #include <Entity.hpp>
 #include <Keyboard.hpp>
 #include <Mouse.hpp>
@@ -125,6 +126,8 @@ void ScriptManager::ExecuteFunction(
     uint32_t moduleIndex
 )
 {
+    LUSTRA_PROFILE_ZONE("ScriptManager::ExecuteFunction");
+
     auto module = engine->GetModule((script->path.stem().string() + std::to_string(moduleIndex)).c_str());
     auto func = module->GetFunctionByDecl(declaration.data());
 
@@ -832,7 +835,8 @@ void ScriptManager::RegisterNameComponent()
 {
     AddType("NameComponent", sizeof(NameComponent), {},
         {
-            { "string name", asOFFSET(NameComponent, name) }
+            // Read-only so renames go through Scene::RenameEntity and reach the name index
+            { "const string name", asOFFSET(NameComponent, name) }
         }
     );
 }
@@ -841,13 +845,18 @@ void ScriptManager::RegisterTransformComponent()
 {
     AddType("TransformComponent", sizeof(TransformComponent),
         {
-            { "glm::mat4 GetTransform() const", WRAP_MFN(TransformComponent, GetTransform) },
-            { "void SetTransform(const glm::mat4& in)", WRAP_MFN(TransformComponent, SetTransform) }
+            { "const glm::mat4& GetTransform() const", WRAP_MFN(TransformComponent, GetTransform) },
+            { "void SetTransform(const glm::mat4& in)", WRAP_MFN(TransformComponent, SetTransform) },
+            { "const glm::vec3& get_position() const property", WRAP_MFN(TransformComponent, GetPosition) },
+            { "void set_position(const glm::vec3& in) property", WRAP_MFN(TransformComponent, SetPosition) },
+            { "const glm::quat& get_rotation() const property", WRAP_MFN(TransformComponent, GetRotation) },
+            { "void set_rotation(const glm::quat& in) property", WRAP_MFN(TransformComponent, SetRotation) },
+            { "glm::vec3 get_eulerAngles() const property", WRAP_MFN(TransformComponent, GetEulerAngles) },
+            { "void set_eulerAngles(const glm::vec3& in) property", WRAP_MFN(TransformComponent, SetEulerAngles) },
+            { "const glm::vec3& get_scale() const property", WRAP_MFN(TransformComponent, GetScale) },
+            { "void set_scale(const glm::vec3& in) property", WRAP_MFN(TransformComponent, SetScale) }
         },
         {
-            { "glm::vec3 position", asOFFSET(TransformComponent, position) },
-            { "glm::vec3 rotation", asOFFSET(TransformComponent, rotation) },
-            { "glm::vec3 scale", asOFFSET(TransformComponent, scale) },
             { "bool overridePhysics", asOFFSET(TransformComponent, overridePhysics) }
         }
     );
@@ -1017,21 +1026,21 @@ void ScriptManager::RegisterEntity()
 
 
 
-            { "NameComponent@ RemoveNameComponent()", WRAP_MFN(Entity, RemoveComponent<NameComponent>) },
-            { "TransformComponent@ RemoveTransformComponent()", WRAP_MFN(Entity, RemoveComponent<TransformComponent>) },
-            { "MeshComponent@ RemoveMeshComponent()", WRAP_MFN(Entity, RemoveComponent<MeshComponent>) },
-            { "MeshRendererComponent@ RemoveMeshRendererComponent()", WRAP_MFN(Entity, RemoveComponent<MeshRendererComponent>) },
-            { "LightComponent@ RemoveLightComponent()", WRAP_MFN(Entity, RemoveComponent<LightComponent>) },
-            { "CameraComponent@ RemoveCameraComponent()", WRAP_MFN(Entity, RemoveComponent<CameraComponent>) },
-            { "RigidBodyComponent@ RemoveRigidBodyComponent()", WRAP_MFN(Entity, RemoveComponent<RigidBodyComponent>) },
+            { "NameComponent@ RemoveNameComponent()", WRAP_OBJ_LAST(as::RemoveComponent<NameComponent>) },
+            { "TransformComponent@ RemoveTransformComponent()", WRAP_OBJ_LAST(as::RemoveComponent<TransformComponent>) },
+            { "MeshComponent@ RemoveMeshComponent()", WRAP_OBJ_LAST(as::RemoveComponent<MeshComponent>) },
+            { "MeshRendererComponent@ RemoveMeshRendererComponent()", WRAP_OBJ_LAST(as::RemoveComponent<MeshRendererComponent>) },
+            { "LightComponent@ RemoveLightComponent()", WRAP_OBJ_LAST(as::RemoveComponent<LightComponent>) },
+            { "CameraComponent@ RemoveCameraComponent()", WRAP_OBJ_LAST(as::RemoveComponent<CameraComponent>) },
+            { "RigidBodyComponent@ RemoveRigidBodyComponent()", WRAP_OBJ_LAST(as::RemoveComponent<RigidBodyComponent>) },
 
-            { "ProceduralSkyComponent@ RemoveProceduralSkyComponent()", WRAP_MFN(Entity, RemoveComponent<ProceduralSkyComponent>) },
-            { "HDRISkyComponent@ RemoveHDRISkyComponent()", WRAP_MFN(Entity, RemoveComponent<HDRISkyComponent>) },
+            { "ProceduralSkyComponent@ RemoveProceduralSkyComponent()", WRAP_OBJ_LAST(as::RemoveComponent<ProceduralSkyComponent>) },
+            { "HDRISkyComponent@ RemoveHDRISkyComponent()", WRAP_OBJ_LAST(as::RemoveComponent<HDRISkyComponent>) },
 
-            { "TonemapComponent@ RemoveTonemapComponent()", WRAP_MFN(Entity, RemoveComponent<TonemapComponent>) },
-            { "BloomComponent@ RemoveBloomComponent()", WRAP_MFN(Entity, RemoveComponent<BloomComponent>) },
-            { "GTAOComponent@ RemoveGTAOComponent()", WRAP_MFN(Entity, RemoveComponent<GTAOComponent>) },
-            { "SSRComponent@ RemoveSSRComponent()", WRAP_MFN(Entity, RemoveComponent<SSRComponent>) }
+            { "TonemapComponent@ RemoveTonemapComponent()", WRAP_OBJ_LAST(as::RemoveComponent<TonemapComponent>) },
+            { "BloomComponent@ RemoveBloomComponent()", WRAP_OBJ_LAST(as::RemoveComponent<BloomComponent>) },
+            { "GTAOComponent@ RemoveGTAOComponent()", WRAP_OBJ_LAST(as::RemoveComponent<GTAOComponent>) },
+            { "SSRComponent@ RemoveSSRComponent()", WRAP_OBJ_LAST(as::RemoveComponent<SSRComponent>) }
         },
         {}
     );
@@ -1044,11 +1053,12 @@ void ScriptManager::RegisterScene()
             { "void Start()", WRAP_MFN(Scene, Start) },
             { "void Update(float deltaTime)", WRAP_MFN(Scene, Update) },
             { "Entity CreateEntity()", WRAP_MFN(Scene, CreateEntity) },
-            { "void RemoveEntity(Entity)", WRAP_MFN(Scene, RemoveEntity) },
-            { "void ReparentEntity(Entity, Entity)", WRAP_MFN(Scene, ReparentEntity) },
+            { "void RemoveEntity(Entity)", WRAP_OBJ_LAST(as::RemoveEntity) },
+            { "void ReparentEntity(Entity, Entity)", WRAP_OBJ_LAST(as::ReparentEntity) },
             { "Entity CloneEntity(Entity)", WRAP_MFN(Scene, CloneEntity) },
             { "Entity GetEntity(uint32)", WRAP_MFN_PR(Scene, GetEntity, (entt::id_type), Entity) },
             { "Entity GetEntity(const string& in)", WRAP_MFN_PR(Scene, GetEntity, (const std::string&), Entity) },
+            { "void RenameEntity(Entity, const string& in)", WRAP_MFN(Scene, RenameEntity) },
             { "bool IsChildOf(Entity, Entity)", WRAP_MFN(Scene, IsChildOf) },
             { "glm::mat4 GetWorldTransform(Entity)", WRAP_OBJ_LAST(as::GetWorldTransform) }
         }, {}